@@ -30,6 +30,11 @@ android {
             )
         }
     }
+    androidResources {
+        // Las PatternDB binarias se leen con AAsset_getBuffer: sin comprimir
+        // el asset queda mapeado directamente desde el APK
+        noCompress += "pdb"
+    }
     compileOptions {
         sourceCompatibility = JavaVersion.VERSION_1_8
         targetCompatibility = JavaVersion.VERSION_1_8
@@ -1,390 +1,487 @@
 // patterndb_solver.cpp
+// Capa JNI sobre el núcleo del solver (solver/): convierte los argumentos de
+// Java, instala el acceso a los assets del APK y da formato a los resultados.
 
 #include <jni.h>
 #include <string>
 #include <vector>
 #include <sstream>
-#include <fstream>
-#include <cstdlib>
-#include <cmath>
-#include <limits>
-#include <chrono>
-#include <unordered_set>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
 #include <unordered_map>
 #include <pthread.h>
-#include "include/nlohmann/json.hpp"  // Usando nlohmann::json
 #include <android/asset_manager.h>
 #include <android/asset_manager_jni.h>
+#include "solver/anytime.h"
+#include "solver/batch.h"
+#include "solver/grid_solver.h"
+#include "solver/ida_star.h"
+#include "solver/pattern_db.h"
+#include "solver/pdb_generator.h"
+#include "solver/puzzle.h"
 
-using json = nlohmann::json;
 using namespace std;
 
-const int INF = 100000;
 AAssetManager* g_assetManager = nullptr;
 
+// Opciones de búsqueda de la app: el reflejo de la PDB reduce los nodos
+// expandidos sin memoria adicional
+SearchOptions appSearchOptions() {
+    SearchOptions options;
+    options.reflect = true;
+    return options;
+}
+
+// Asset abierto en modo buffer: si el asset no está comprimido en el APK
+// (noCompress "pdb"), AAsset_getBuffer apunta al APK mapeado en memoria.
+class AssetBlob : public PdbBlob {
+public:
+    AssetBlob(AAsset* asset, const void* buffer, size_t length)
+            : asset(asset), buffer((const uint8_t*)buffer), length(length) {}
+    ~AssetBlob() override { AAsset_close(asset); }
+    const uint8_t* data() const override { return buffer; }
+    size_t size() const override { return length; }
+private:
+    AAsset* asset;
+    const uint8_t* buffer;
+    size_t length;
+};
+
+// AssetOpener del núcleo para los assets del APK
+unique_ptr<PdbBlob> openPdbAsset(const string& filename) {
+    if (g_assetManager == nullptr)
+        return nullptr;
+    AAsset* asset = AAssetManager_open(g_assetManager, filename.c_str(), AASSET_MODE_BUFFER);
+    if (asset == nullptr)
+        return nullptr;
+    const void* buffer = AAsset_getBuffer(asset);
+    if (buffer == nullptr) {
+        AAsset_close(asset);
+        return nullptr;
+    }
+    return unique_ptr<PdbBlob>(new AssetBlob(asset, buffer, (size_t)AAsset_getLength(asset)));
+}
+
 // ------------------------------------------------------
-// Clase Puzzle
+// Worker nativo persistente: un único hilo (creado una vez, con stack
+// grande) resuelve las peticiones asíncronas en orden e informa del progreso
+// y del resultado a un SolveCallback de Java desde este hilo. Las síncronas
+// se resuelven en el hilo del llamador (los motores no son recursivos, no
+// necesitan stack grande): no esperan detrás de una asíncrona larga y se
+// pueden llamar desde un SolveCallback sin bloquear al worker.
 // ------------------------------------------------------
-class Puzzle {
-public:
-    int boardSize;
-    vector<vector<int>> board;
-    int blankRow, blankCol;
-
-    // Direcciones: abajo, arriba, derecha, izquierda
-    static const vector<pair<int,int>> DIRECTIONS;
-
-    Puzzle(int boardSize) : boardSize(boardSize) {
-        board.resize(boardSize, vector<int>(boardSize));
-        for (int i = 0; i < boardSize; i++){
-            for (int j = 0; j < boardSize; j++){
-                board[i][j] = i * boardSize + j + 1;
-            }
-        }
-        blankRow = boardSize - 1;
-        blankCol = boardSize - 1;
-        board[blankRow][blankCol] = 0;
+struct SolveJob {
+    jlong handle = 0;
+    string input;
+    bool parallel = false;      // IDA* paralelo sobre el pool compartido
+    SearchLimits limits;        // tiempo máximo y presupuesto de nodos
+    double weight = 1.0;        // > 1: IDA* con peso (ver SearchOptions::weight)
+    bool anytime = false;       // mejora la solución hasta el límite (ver anytimeSolve)
+    CancellationToken cancel;
+    jobject callback = nullptr; // referencia global; nullptr en las síncronas
+};
+
+// Resuelve la petición con la PatternDB por defecto (cacheada) y da formato
+// al resultado: los pasos del camino o el mensaje de error
+string runSolveJob(SolveJob &job, const SearchProgress &progress) {
+    Puzzle puzzle(4);
+    string error;
+    if (!parsePuzzle(job.input, puzzle, error))
+        return error;
+    if (!isSolvable(puzzle))
+        return "Error: El tablero no tiene solución.";
+    SearchOptions options = appSearchOptions();
+    options.limits = job.limits;
+    options.limits.cancel = &job.cancel;
+    options.weight = job.weight;
+    options.progress = progress;
+    SearchStats stats;
+    vector<pair<int,int>> moves;
+    if (puzzle.rows == PackedState::SIDE && puzzle.cols == PackedState::SIDE) {
+        shared_ptr<const PatternDatabase> db = defaultPatternDB(4);
+        if (!db)
+            return "Error al cargar PatternDB.";
+        if (job.anytime)
+            moves = anytimeSolve(puzzle, db.get(), options, &stats);
+        else
+            moves = job.parallel ? parallelIDAStar(puzzle, *db, sharedPool(), options, &stats)
+                                 : iterativeIDAStar(puzzle, *db, options, &stats);
+    } else {
+        // Motor especializado para rows x cols, con patternDb_<n>.pdb si el
+        // tablero es cuadrado y existe (5x5: "6-6-6-6")
+        shared_ptr<const PatternDatabase> db;
+        if (puzzle.rows == puzzle.cols && puzzle.rows <= PDB_MAX_BOARD_SIDE)
+            db = defaultPatternDB(puzzle.rows);
+        moves = job.anytime ? anytimeSolve(puzzle, db.get(), options, &stats) : solveGrid(puzzle, db.get(), options, &stats);
+    }
+    ostringstream oss;
+    if (stats.status != SolveStatus::Solved) {
+        oss << solveStatusMessage(stats.status);
+        if (stats.status == SolveStatus::Timeout || stats.status == SolveStatus::BudgetExhausted)
+            oss << " (nodos: " << stats.nodes << ", longitud mínima: " << stats.bound << ")";
+        return oss.str();
+    }
+    vector<string> pathStates = reconstructPath(puzzle, moves);
+    for (size_t i = 0; i < pathStates.size(); i++) {
+        oss << "Paso " << i << ":\n" << pathStates[i] << "\n";
     }
+    if (stats.suboptimality > 1.0)
+        oss << "Solución de " << moves.size() << " movimientos, como mucho " << stats.suboptimality
+            << " veces la óptima (longitud mínima: " << stats.bound << ")\n";
+    return oss.str();
+}
 
-    // Constructor copia
-    Puzzle(const Puzzle &other) {
-        boardSize = other.boardSize;
-        board = other.board;
-        blankRow = other.blankRow;
-        blankCol = other.blankCol;
+class SolveWorker {
+public:
+    // Crea el hilo en la primera llamada
+    static SolveWorker& instance(JavaVM* vm) {
+        static SolveWorker* worker = new SolveWorker(vm);
+        return *worker;
     }
 
-    Puzzle& operator=(const Puzzle &other) {
-        if (this != &other) {
-            boardSize = other.boardSize;
-            board = other.board;
-            blankRow = other.blankRow;
-            blankCol = other.blankCol;
+    // Encola la petición y le asigna un handle
+    jlong submit(const shared_ptr<SolveJob> &job) {
+        {
+            lock_guard<mutex> lock(queueMutex);
+            job->handle = nextHandle++;
+            queue.push_back(job);
+            jobs[job->handle] = job;
         }
-        return *this;
+        wakeUp.notify_one();
+        return job->handle;
     }
 
-    // Comprueba si el puzzle está resuelto
-    bool checkWin() const {
-        for (int i = 0; i < boardSize; i++){
-            for (int j = 0; j < boardSize; j++){
-                if (i == boardSize - 1 && j == boardSize - 1)
-                    continue;
-                if (board[i][j] != i * boardSize + j + 1)
-                    return false;
-            }
+    // Resuelve una petición síncrona en el hilo del llamador; mientras dura
+    // está registrada para que cancelAll también la detenga
+    string runHere(const shared_ptr<SolveJob> &job) {
+        {
+            lock_guard<mutex> lock(queueMutex);
+            job->handle = nextHandle++;
+            jobs[job->handle] = job;
         }
-        return true;
+        string result = runSolveJob(*job, SearchProgress());
+        lock_guard<mutex> lock(queueMutex);
+        jobs.erase(job->handle);
+        return result;
     }
 
-    // Mueve la celda vacía en la dirección (dx, dy)
-    bool move(int dx, int dy) {
-        int newRow = blankRow + dx;
-        int newCol = blankCol + dy;
-        if (newRow < 0 || newRow >= boardSize || newCol < 0 || newCol >= boardSize)
+    // Una petición en cola también se cancela: al llegar su turno retorna
+    // sin buscar. false si el handle ya terminó.
+    bool cancel(jlong handle) {
+        lock_guard<mutex> lock(queueMutex);
+        auto it = jobs.find(handle);
+        if (it == jobs.end())
             return false;
-        board[blankRow][blankCol] = board[newRow][newCol];
-        board[newRow][newCol] = 0;
-        blankRow = newRow;
-        blankCol = newCol;
+        it->second->cancel.cancel();
         return true;
     }
 
-    // Simula un movimiento y retorna (bool, Puzzle)
-    pair<bool, Puzzle> simulateMove(const pair<int,int>& dir) const {
-        Puzzle sim(*this);
-        bool valid = sim.move(dir.first, dir.second);
-        return make_pair(valid, sim);
+    void cancelAll() {
+        lock_guard<mutex> lock(queueMutex);
+        for (auto &entry : jobs){
+            entry.second->cancel.cancel();
+        }
     }
 
-    // Genera un hash del estado considerando sólo las piezas en "group"
-    string hash(const unordered_set<int>& group) const {
-        ostringstream oss;
-        for (int i = 0; i < boardSize; i++){
-            for (int j = 0; j < boardSize; j++){
-                int tile = board[i][j];
-                if (group.find(tile) != group.end()){
-                    oss << i << j;  // Suponiendo boardSize < 10
-                }
-            }
-        }
-        return oss.str();
+private:
+    JavaVM* vm;
+    mutex queueMutex;
+    condition_variable wakeUp;
+    deque<shared_ptr<SolveJob>> queue;
+    unordered_map<jlong, shared_ptr<SolveJob>> jobs; // en cola o en curso
+    jlong nextHandle = 1;
+
+    explicit SolveWorker(JavaVM* vm) : vm(vm) {
+        pthread_t thread;
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        pthread_attr_setstacksize(&attr, 16 * 1024 * 1024); // 16 MB de stack
+        pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+        pthread_create(&thread, &attr, [](void* self) -> void* {
+            ((SolveWorker*)self)->run();
+            return nullptr;
+        }, this);
+        pthread_attr_destroy(&attr);
     }
 
-    // Representa el estado en forma de cadena
-    string toString() const {
-        ostringstream oss;
-        for (int i = 0; i < boardSize; i++){
-            for (int j = 0; j < boardSize; j++){
-                oss << board[i][j] << "\t";
+    void run() {
+        JNIEnv* env = nullptr;
+        vm->AttachCurrentThread(&env, nullptr);
+        while (true) {
+            shared_ptr<SolveJob> job;
+            {
+                unique_lock<mutex> lock(queueMutex);
+                wakeUp.wait(lock, [this] { return !queue.empty(); });
+                job = queue.front();
+                queue.pop_front();
             }
-            oss << "\n";
+            runAsync(env, *job);
+            lock_guard<mutex> lock(queueMutex);
+            jobs.erase(job->handle);
         }
-        return oss.str();
+    }
+
+    void runAsync(JNIEnv* env, SolveJob &job) {
+        jclass callbackClass = env->GetObjectClass(job.callback);
+        jmethodID onProgress = env->GetMethodID(callbackClass, "onProgress", "(JIJ)V");
+        jmethodID onResult = env->GetMethodID(callbackClass, "onResult", "(JLjava/lang/String;)V");
+        env->DeleteLocalRef(callbackClass);
+        string result = runSolveJob(job, [&](int bound, uint64_t nodes) {
+            env->CallVoidMethod(job.callback, onProgress, job.handle, (jint)bound, (jlong)nodes);
+            if (env->ExceptionCheck())
+                env->ExceptionClear();
+        });
+        jstring value = env->NewStringUTF(result.c_str());
+        env->CallVoidMethod(job.callback, onResult, job.handle, value);
+        if (env->ExceptionCheck())
+            env->ExceptionClear();
+        env->DeleteLocalRef(value);
+        env->DeleteGlobalRef(job.callback);
     }
 };
 
-const vector<pair<int,int>> Puzzle::DIRECTIONS = { {1,0}, {-1,0}, {0,1}, {0,-1} };
+// Copia un jstring a std::string
+string jstringToString(JNIEnv* env, jstring value) {
+    const char* chars = env->GetStringUTFChars(value, nullptr);
+    string result(chars);
+    env->ReleaseStringUTFChars(value, chars);
+    return result;
+}
+
+SolveWorker& solveWorker(JNIEnv* env) {
+    JavaVM* vm = nullptr;
+    env->GetJavaVM(&vm);
+    return SolveWorker::instance(vm);
+}
+
+// Resuelve en el hilo del llamador
+jstring solveHere(JNIEnv* env, const shared_ptr<SolveJob> &job) {
+    return env->NewStringUTF(solveWorker(env).runHere(job).c_str());
+}
 
 // ------------------------------------------------------
-// Global PatternDB variables
+// Función JNI para resolver el puzzle (se ejecuta en el hilo del llamador)
+// Recibe un jstring con la matriz y retorna un jstring con el camino de solución.
+// Bloquea al llamador: desde la UI usar solvePuzzleAsync.
 // ------------------------------------------------------
-vector<unordered_set<int>> g_groups;
-vector<unordered_map<string, int>> g_patternDbDict;
+extern "C"
+JNIEXPORT jstring JNICALL
+Java_com_example_patterndb_NativeSolver_NativeSolver_solvePuzzle(JNIEnv* env, jobject thiz, jstring puzzleStr) {
+    auto job = make_shared<SolveJob>();
+    job->input = jstringToString(env, puzzleStr);
+    return solveHere(env, job);
+}
 
-// Función para cargar la PatternDB desde un archivo JSON en assets
-bool loadPatternDB(const string& filename, int boardSize) {
-    if(g_assetManager == nullptr) {
-        return false;
-    }
-    AAsset* asset = AAssetManager_open(g_assetManager, filename.c_str(), AASSET_MODE_STREAMING);
-    if (asset == nullptr) {
-        return false;
-    }
-    size_t size = AAsset_getLength(asset);
-    string jsonStr;
-    jsonStr.resize(size);
-    int bytesRead = AAsset_read(asset, &jsonStr[0], size);
-    AAsset_close(asset);
-    if(bytesRead <= 0) {
-        return false;
-    }
-    try {
-        json j = json::parse(jsonStr);
-        g_groups.clear();
-        g_patternDbDict.clear();
-        for (auto& grp : j["groups"]) {
-            unordered_set<int> group;
-            for (auto& num : grp) {
-                group.insert(num.get<int>());
-            }
-            g_groups.push_back(group);
-        }
-        for (auto& obj : j["patternDbDict"]) {
-            unordered_map<string, int> dict;
-            for (auto it = obj.begin(); it != obj.end(); ++it) {
-                dict[it.key()] = it.value().get<int>();
-            }
-            g_patternDbDict.push_back(dict);
-        }
-    } catch (...) {
-        return false;
-    }
-    return true;
+// ------------------------------------------------------
+// Igual que solvePuzzle pero reparte cada iteración de IDA* entre todos los
+// núcleos (mismo resultado que la versión secuencial)
+// ------------------------------------------------------
+extern "C"
+JNIEXPORT jstring JNICALL
+Java_com_example_patterndb_NativeSolver_NativeSolver_solvePuzzleParallel(JNIEnv* env, jobject thiz, jstring puzzleStr) {
+    auto job = make_shared<SolveJob>();
+    job->input = jstringToString(env, puzzleStr);
+    job->parallel = true;
+    return solveHere(env, job);
+}
+
+// Petición con límites: timeoutMillis y maxNodes a 0 no limitan
+shared_ptr<SolveJob> limitedJob(JNIEnv* env, jstring puzzleStr, jboolean parallel, jlong timeoutMillis, jlong maxNodes) {
+    auto job = make_shared<SolveJob>();
+    job->input = jstringToString(env, puzzleStr);
+    job->parallel = parallel == JNI_TRUE;
+    job->limits.timeoutMicros = timeoutMillis > 0 ? (int64_t)timeoutMillis * 1000 : 0;
+    job->limits.maxNodes = maxNodes > 0 ? (uint64_t)maxNodes : 0;
+    return job;
 }
 
 // ------------------------------------------------------
-// Funciones heurísticas
+// solvePuzzle con límites: timeoutMillis y maxNodes a 0 no limitan. Si un
+// límite detiene la búsqueda retorna el motivo con los nodos generados y la
+// cota inferior alcanzada.
 // ------------------------------------------------------
-int manhattan(const Puzzle &puzzle, const unordered_set<int>& group) {
-    int h = 0;
-    for (int i = 0; i < puzzle.boardSize; i++){
-        for (int j = 0; j < puzzle.boardSize; j++){
-            int tile = puzzle.board[i][j];
-            if (tile != 0 && group.find(tile) != group.end()){
-                int destRow = (tile - 1) / puzzle.boardSize;
-                int destCol = (tile - 1) % puzzle.boardSize;
-                h += abs(destRow - i) + abs(destCol - j);
-            }
-        }
-    }
-    return h;
+extern "C"
+JNIEXPORT jstring JNICALL
+Java_com_example_patterndb_NativeSolver_NativeSolver_solvePuzzleWithLimits(JNIEnv* env, jobject thiz, jstring puzzleStr,
+                                                                           jboolean parallel, jlong timeoutMillis,
+                                                                           jlong maxNodes) {
+    return solveHere(env, limitedJob(env, puzzleStr, parallel, timeoutMillis, maxNodes));
 }
 
-int hScore(const Puzzle &puzzle) {
-    int h = 0;
-    for (size_t i = 0; i < g_groups.size(); i++){
-        const auto &group = g_groups[i];
-        string hashStr = puzzle.hash(group);
-        const auto &dict = g_patternDbDict[i];
-        auto it = dict.find(hashStr);
-        if (it != dict.end()){
-            h += it->second;
-        } else {
-            h += manhattan(puzzle, group);
-        }
-    }
-    return h;
+// ------------------------------------------------------
+// solvePuzzleWithLimits con IDA* con peso: f = g + weight·h (de 1 a 8; 1 es
+// la solución óptima). Con peso la solución mide como mucho weight veces la
+// óptima y cuesta muchos menos nodos; al final se añade el factor probado.
+// ------------------------------------------------------
+extern "C"
+JNIEXPORT jstring JNICALL
+Java_com_example_patterndb_NativeSolver_NativeSolver_solvePuzzleWeighted(JNIEnv* env, jobject thiz, jstring puzzleStr,
+                                                                         jboolean parallel, jdouble weight,
+                                                                         jlong timeoutMillis, jlong maxNodes) {
+    auto job = limitedJob(env, puzzleStr, parallel, timeoutMillis, maxNodes);
+    job->weight = min(max((double)weight, 1.0), MAX_SEARCH_WEIGHT);
+    return solveHere(env, job);
 }
 
 // ------------------------------------------------------
-// Estructura para simular un nodo en la búsqueda iterativa
+// Resolución anytime para uso interactivo: una solución rápida con peso que
+// se mejora hasta agotar timeoutMillis o probar que es óptima. Retorna la
+// mejor encontrada y, si no se probó óptima, el factor respecto al óptimo.
+// Sin timeoutMillis (0) termina con la solución óptima.
 // ------------------------------------------------------
-struct Node {
-    Puzzle state;
-    int g; // costo acumulado (profundidad)
-    int dirIndex; // índice del siguiente movimiento a probar
-    vector<pair<int,int>> moves; // camino de movimientos
-
-    // Constructor para inicializar todos los campos
-    Node(const Puzzle &state, int g, int dirIndex, const vector<pair<int,int>> &moves)
-            : state(state), g(g), dirIndex(dirIndex), moves(moves) {}
-};
+extern "C"
+JNIEXPORT jstring JNICALL
+Java_com_example_patterndb_NativeSolver_NativeSolver_solvePuzzleAnytime(JNIEnv* env, jobject thiz, jstring puzzleStr,
+                                                                        jlong timeoutMillis) {
+    auto job = limitedJob(env, puzzleStr, JNI_FALSE, timeoutMillis, 0);
+    job->anytime = true;
+    return solveHere(env, job);
+}
 
 // ------------------------------------------------------
-// Función iterativa IDA* usando un stack en el heap
+// Resolución asíncrona: encola el tablero en el worker nativo y retorna su
+// handle de inmediato. callback.onProgress(handle, límite, nodos) se llama al
+// empezar cada iteración de IDA* y callback.onResult(handle, resultado) al
+// terminar, ambos desde el hilo del worker.
 // ------------------------------------------------------
-vector<pair<int,int>> iterativeIDAStar(const Puzzle &initial) {
-    int bound = hScore(initial);
-    while (true) {
-        vector<Node> stack;
-        Node root(initial, 0, 0, {});
-        root.state = initial;
-        root.g = 0;
-        root.dirIndex = 0;
-        root.moves = {};
-        stack.push_back(root);
-
-        int newBound = INF;
-        bool found = false;
-        vector<pair<int,int>> solutionMoves;
-
-        while (!stack.empty() && !found) {
-            Node &top = stack.back();
-            int f = top.g + hScore(top.state);
-            if (f > bound) {
-                newBound = min(newBound, f);
-                stack.pop_back();
-                continue;
-            }
-            if (top.state.checkWin()) {
-                found = true;
-                solutionMoves = top.moves;
-                break;
-            }
-            if (top.dirIndex >= (int)Puzzle::DIRECTIONS.size()) {
-                stack.pop_back();
-                continue;
-            }
-            pair<int,int> dir = Puzzle::DIRECTIONS[top.dirIndex];
-            top.dirIndex++;  // Incrementa para probar el siguiente movimiento en futuras iteraciones
-
-            // Evitar revertir el último movimiento
-            if (!top.moves.empty()) {
-                pair<int,int> last = top.moves.back();
-                if (dir.first == -last.first && dir.second == -last.second)
-                    continue;
-            }
-            auto sim = top.state.simulateMove(dir);
-            if (!sim.first)
-                continue;
-            Node child(initial, 0, 0, {});
-            child.state = sim.second;
-            child.g = top.g + 1;
-            child.dirIndex = 0;
-            child.moves = top.moves;
-            child.moves.push_back(dir);
-            stack.push_back(child);
-        }
-        if (found) {
-            return solutionMoves;
-        }
-        if (newBound == INF)
-            return vector<pair<int,int>>(); // No se encontró solución
-        bound = newBound;
-    }
+extern "C"
+JNIEXPORT jlong JNICALL
+Java_com_example_patterndb_NativeSolver_NativeSolver_solvePuzzleAsync(JNIEnv* env, jobject thiz, jstring puzzleStr,
+                                                                      jboolean parallel, jlong timeoutMillis,
+                                                                      jlong maxNodes, jobject callback) {
+    auto job = limitedJob(env, puzzleStr, parallel, timeoutMillis, maxNodes);
+    job->callback = env->NewGlobalRef(callback);
+    return solveWorker(env).submit(job);
 }
 
 // ------------------------------------------------------
-// Reconstruye el camino de estados (cada matriz) a partir de los movimientos
+// Cancela una resolución asíncrona (en cola o en curso); su onResult llega
+// con "Resolución cancelada". false si ya había terminado.
 // ------------------------------------------------------
-vector<string> reconstructPath(const Puzzle &initial, const vector<pair<int,int>> &moves) {
-    vector<string> states;
-    Puzzle temp = initial;
-    states.push_back(temp.toString());
-    for (auto move : moves) {
-        temp.move(move.first, move.second);
-        states.push_back(temp.toString());
-    }
-    return states;
+extern "C"
+JNIEXPORT jboolean JNICALL
+Java_com_example_patterndb_NativeSolver_NativeSolver_cancelSolve(JNIEnv* env, jobject thiz, jlong handle) {
+    return solveWorker(env).cancel(handle) ? JNI_TRUE : JNI_FALSE;
 }
 
 // ------------------------------------------------------
-// Función JNI auxiliar: Ejecuta la solución en un hilo con mayor stack
+// Cancela todas las resoluciones en cola o en curso (se puede llamar desde
+// cualquier hilo): cada una termina en pocos miles de nodos
 // ------------------------------------------------------
-struct SolveData {
-    string input;
-    string result;
-};
+extern "C"
+JNIEXPORT void JNICALL
+Java_com_example_patterndb_NativeSolver_NativeSolver_cancelSolves(JNIEnv* env, jobject thiz) {
+    solveWorker(env).cancelAll();
+}
 
-void* solveThread(void* arg) {
-    SolveData* data = (SolveData*) arg;
-    // Parsear la cadena, crear Puzzle, cargar PatternDB y resolver
-    // Parsear la entrada en una matriz 4x4
-    vector<vector<int>> matrix;
-    istringstream iss(data->input);
-    string rowStr;
-    while(getline(iss, rowStr, ';')) {
-        istringstream rowStream(rowStr);
-        vector<int> row;
-        int val;
-        while(rowStream >> val) {
-            row.push_back(val);
-        }
-        matrix.push_back(row);
-    }
-    if(matrix.size() != 4 || matrix[0].size() != 4) {
-        data->result = "Error: La matriz debe ser 4x4.";
-        return nullptr;
+// ------------------------------------------------------
+// Función JNI para configurar el AssetManager: a partir de aquí los nombres
+// relativos de PatternDB se abren como assets del APK
+// ------------------------------------------------------
+extern "C"
+JNIEXPORT void JNICALL
+Java_com_example_patterndb_NativeSolver_NativeSolver_setAssetManager(JNIEnv* env, jobject thiz, jobject assetManagerObj) {
+    g_assetManager = AAssetManager_fromJava(env, assetManagerObj);
+    setAssetOpener(openPdbAsset);
+}
+
+// ------------------------------------------------------
+// Función JNI para precargar una PatternDB en el registro del proceso
+// filename: asset (.json o .pdb) o ruta absoluta a un .pdb (se mapea con mmap).
+// Los assets requieren haber llamado antes a setAssetManager.
+// ------------------------------------------------------
+extern "C"
+JNIEXPORT jboolean JNICALL
+Java_com_example_patterndb_NativeSolver_NativeSolver_preloadPatternDB(JNIEnv* env, jobject thiz, jstring filename, jint boardSize) {
+    return preloadPatternDB(jstringToString(env, filename), boardSize) ? JNI_TRUE : JNI_FALSE;
+}
+
+// ------------------------------------------------------
+// Función JNI para convertir una PatternDB JSON (asset o ruta) al formato binario
+// ------------------------------------------------------
+extern "C"
+JNIEXPORT jboolean JNICALL
+Java_com_example_patterndb_NativeSolver_NativeSolver_convertPatternDB(JNIEnv* env, jobject thiz, jstring jsonFilename, jint boardSize, jstring outPath) {
+    bool ok = convertPatternDBJsonToBinary(jstringToString(env, jsonFilename), boardSize, jstringToString(env, outPath));
+    return ok ? JNI_TRUE : JNI_FALSE;
+}
+
+// ------------------------------------------------------
+// Función JNI para generar una PatternDB aditiva ("5-5-5" o "6-6-3") y
+// guardarla en outPath con el formato binario. Puede tardar: no llamar
+// desde el hilo de UI. "7-8" y "6-6-6-6" necesitan más de 1 GB durante la
+// generación y se rechazan: se generan en el host con pdb_tool.
+// ------------------------------------------------------
+extern "C"
+JNIEXPORT jboolean JNICALL
+Java_com_example_patterndb_NativeSolver_NativeSolver_generatePatternDB(JNIEnv* env, jobject thiz, jstring partition, jstring outPath) {
+    string name = jstringToString(env, partition);
+    if (name != "5-5-5" && name != "6-6-3")
+        return JNI_FALSE;
+    bool ok = generatePatternDBFile(name, jstringToString(env, outPath));
+    return ok ? JNI_TRUE : JNI_FALSE;
+}
+
+// Lote de tableros 4x4 con la PatternDB por defecto; withFactor añade a
+// cada resultado resuelto el factor probado respecto al óptimo
+jobjectArray solveBatchArray(JNIEnv* env, jobjectArray puzzles, const SearchOptions &options, bool withFactor = false) {
+    jsize count = env->GetArrayLength(puzzles);
+    vector<string> inputs((size_t)count);
+    for (jsize i = 0; i < count; i++) {
+        jstring item = (jstring) env->GetObjectArrayElement(puzzles, i);
+        inputs[i] = jstringToString(env, item);
+        env->DeleteLocalRef(item);
     }
-    Puzzle puzzle(4);
-    for (int i = 0; i < 4; i++){
-        for (int j = 0; j < 4; j++){
-            puzzle.board[i][j] = matrix[i][j];
-            if(matrix[i][j] == 0){
-                puzzle.blankRow = i;
-                puzzle.blankCol = j;
+    jobjectArray output = env->NewObjectArray(count, env->FindClass("java/lang/String"), nullptr);
+    shared_ptr<const PatternDatabase> db = defaultPatternDB(4);
+    vector<BatchResult> results;
+    if (db)
+        results = solveBatch(inputs, *db, sharedPool(), options);
+    for (jsize i = 0; i < count; i++) {
+        string line;
+        if (!db) {
+            line = "Error al cargar PatternDB.";
+        } else if (results[i].status == SolveStatus::Solved) {
+            line = results[i].moves + ";" + to_string(results[i].micros) + ";" + to_string(results[i].nodes);
+            if (withFactor) {
+                ostringstream factor;
+                factor << results[i].suboptimality;
+                line += ";" + factor.str();
             }
+        } else {
+            line = results[i].error;
         }
+        jstring item = env->NewStringUTF(line.c_str());
+        env->SetObjectArrayElement(output, i, item);
+        env->DeleteLocalRef(item);
     }
-    if (!loadPatternDB("patternDb_4.json", 4)) {
-        data->result = "Error al cargar PatternDB.";
-        return nullptr;
-    }
-    auto moves = iterativeIDAStar(puzzle);
-    vector<string> pathStates = reconstructPath(puzzle, moves);
-    ostringstream oss;
-    for (size_t i = 0; i < pathStates.size(); i++) {
-        oss << "Paso " << i << ":\n" << pathStates[i] << "\n";
-    }
-    data->result = oss.str();
-    return nullptr;
+    return output;
 }
 
 // ------------------------------------------------------
-// Función JNI para resolver el puzzle (se ejecuta en un hilo con mayor stack)
-// Recibe un jstring con la matriz y retorna un jstring con el camino de solución.
+// Función JNI de resolución por lotes. Recibe un String[] de tableros (mismo
+// formato que solvePuzzle) y retorna un String[] con, por tablero,
+// "movimientos;microsegundos;nodos" (movimientos en letras D/U/R/L del hueco)
+// o el mensaje de error.
 // ------------------------------------------------------
 extern "C"
-JNIEXPORT jstring JNICALL
-Java_com_example_patterndb_NativeSolver_NativeSolver_solvePuzzle(JNIEnv* env, jobject thiz, jstring puzzleStr) {
-    const char* cPuzzleStr = env->GetStringUTFChars(puzzleStr, nullptr);
-    string input(cPuzzleStr);
-    env->ReleaseStringUTFChars(puzzleStr, cPuzzleStr);
-
-    SolveData data;
-    data.input = input;
-
-    pthread_t thread;
-    pthread_attr_t attr;
-    pthread_attr_init(&attr);
-    size_t stackSize = 16 * 1024 * 1024; // 16 MB de stack
-    pthread_attr_setstacksize(&attr, stackSize);
-
-    int ret = pthread_create(&thread, &attr, solveThread, &data);
-    pthread_attr_destroy(&attr);
-    if(ret != 0) {
-        return env->NewStringUTF("Error al crear el hilo.");
-    }
-    pthread_join(thread, nullptr);
-    return env->NewStringUTF(data.result.c_str());
+JNIEXPORT jobjectArray JNICALL
+Java_com_example_patterndb_NativeSolver_NativeSolver_solveBatch(JNIEnv* env, jobject thiz, jobjectArray puzzles) {
+    return solveBatchArray(env, puzzles, appSearchOptions());
 }
 
 // ------------------------------------------------------
-// Función JNI para configurar el AssetManager (únicamente)
+// solveBatch con IDA* con peso (ver solvePuzzleWeighted): cada resultado
+// resuelto es "movimientos;microsegundos;nodos;factor", con el factor
+// probado respecto a la solución óptima.
 // ------------------------------------------------------
 extern "C"
-JNIEXPORT void JNICALL
-Java_com_example_patterndb_NativeSolver_NativeSolver_setAssetManager(JNIEnv* env, jobject thiz, jobject assetManagerObj) {
-g_assetManager = AAssetManager_fromJava(env, assetManagerObj);
+JNIEXPORT jobjectArray JNICALL
+Java_com_example_patterndb_NativeSolver_NativeSolver_solveBatchWeighted(JNIEnv* env, jobject thiz, jobjectArray puzzles,
+                                                                        jdouble weight) {
+    SearchOptions options = appSearchOptions();
+    options.weight = min(max((double)weight, 1.0), MAX_SEARCH_WEIGHT);
+    return solveBatchArray(env, puzzles, options, true);
 }
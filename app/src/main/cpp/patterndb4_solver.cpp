@@ -203,9 +203,9 @@ int hScore(const Puzzle &puzzle) {
 
 // ------------------------------------------------------
 // Función recursiva search (IDA*) – similar a la versión Python
+// Aplica y deshace cada movimiento sobre el mismo Puzzle (sin copias por nodo)
 // ------------------------------------------------------
-int search(vector<Puzzle>& path, int g, int bound, vector<pair<int,int>>& dirs) {
-    Puzzle &cur = path.back();
+int search(Puzzle& cur, int g, int bound, vector<pair<int,int>>& dirs) {
     int f = g + hScore(cur);
     if (f > bound)
         return f;
@@ -219,22 +219,16 @@ int search(vector<Puzzle>& path, int g, int bound, vector<pair<int,int>>& dirs)
             if (dir.first == -last.first && dir.second == -last.second)
                 continue;
         }
-        // Simular movimiento
-        auto sim = cur.simulateMove(dir);
-        if (!sim.first)
+        if (!cur.move(dir.first, dir.second))
             continue;
-        if (false) { 
-            // Aquí podrías verificar si el estado ya está en el camino para evitar ciclos.
-            // Para simplicidad, se omite (pero en una implementación robusta se haría)
-        }
-        path.push_back(sim.second);
         dirs.push_back(dir);
-        int t = search(path, g + 1, bound, dirs);
+        int t = search(cur, g + 1, bound, dirs);
         if (t == -1)
             return -1;
         if (t < min_val)
             min_val = t;
-        path.pop_back();
+        // Deshacer el movimiento
+        cur.move(-dir.first, -dir.second);
         dirs.pop_back();
     }
     return min_val;
@@ -244,11 +238,10 @@ vector<pair<int,int>> idaStar(Puzzle puzzle) {
     if (puzzle.checkWin())
         return vector<pair<int,int>>(); // Ya resuelto
     int bound = hScore(puzzle);
-    vector<Puzzle> path;
-    path.push_back(puzzle);
     vector<pair<int,int>> dirs;
+    dirs.reserve(128);
     while (true) {
-        int t = search(path, 0, bound, dirs);
+        int t = search(puzzle, 0, bound, dirs);
         if (t == -1)
             return dirs; // Secuencia de movimientos óptima encontrada
         if (t == INF)
@@ -0,0 +1,111 @@
+// anytime.cpp
+
+#include "anytime.h"
+#include "grid_solver.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+using namespace std;
+
+// Por debajo de este peso la siguiente pasada es ya sin peso
+const double ANYTIME_MIN_WEIGHT = 1.1;
+
+int boardManhattan(const Puzzle &puzzle) {
+    int total = 0;
+    for (int row = 0; row < puzzle.rows; row++){
+        for (int col = 0; col < puzzle.cols; col++){
+            int tile = puzzle.board[row][col];
+            if (tile != 0)
+                total += abs(row - (tile - 1) / puzzle.cols) + abs(col - (tile - 1) % puzzle.cols);
+        }
+    }
+    return total;
+}
+
+vector<pair<int,int>> anytimeSolve(const Puzzle &puzzle, const PatternDatabase* db, const SearchOptions &options,
+                                   SearchStats* stats) {
+    SearchStats local;
+    if (stats == nullptr)
+        stats = &local;
+    *stats = SearchStats();
+    bool packed = db != nullptr && puzzle.rows == PackedState::SIDE && puzzle.cols == PackedState::SIDE;
+    auto deadline = chrono::steady_clock::now() + chrono::microseconds(options.limits.timeoutMicros);
+    double weight = options.weight > 1.0 ? min(options.weight, MAX_SEARCH_WEIGHT) : ANYTIME_START_WEIGHT;
+    // Las soluciones con peso miden como mucho w·C* y C* >= Manhattan: con
+    // w·Manhattan fuera de MovePath esa garantía ya no cabe y la pasada suele
+    // agotarse contra la poda de profundidad. Limitar w a que quepa
+    // w·Manhattan evita ese caso pero no garantiza que quepa w·C*.
+    int manhattan = boardManhattan(puzzle);
+    if (manhattan > 0)
+        weight = min(weight, (double)(MovePath::MAX_DEPTH - 1) / manhattan);
+    if (weight < ANYTIME_MIN_WEIGHT)
+        weight = 1.0;
+    vector<pair<int,int>> best;
+    bool solved = false;
+    int lowerBound = 0;
+    uint64_t nodes = 0;
+    while (true) {
+        SearchOptions pass = options;
+        pass.weight = weight;
+        pass.costLimit = solved ? (int)best.size() : 0;
+        if (options.limits.timeoutMicros > 0) {
+            auto remaining = chrono::duration_cast<chrono::microseconds>(deadline - chrono::steady_clock::now()).count();
+            if (remaining <= 0) {
+                stats->status = SolveStatus::Timeout;
+                break;
+            }
+            pass.limits.timeoutMicros = remaining;
+        }
+        if (options.limits.maxNodes > 0) {
+            if (nodes >= options.limits.maxNodes) {
+                stats->status = SolveStatus::BudgetExhausted;
+                break;
+            }
+            pass.limits.maxNodes = options.limits.maxNodes - nodes;
+        }
+
+        SearchStats passStats;
+        vector<pair<int,int>> moves = packed ? iterativeIDAStar(puzzle, *db, pass, &passStats)
+                                             : solveGrid(puzzle, db, pass, &passStats);
+        nodes += passStats.nodes;
+        stats->status = passStats.status;
+        lowerBound = max(lowerBound, passStats.bound);
+        if (passStats.status == SolveStatus::NoSolution && !solved && weight > 1.0) {
+            // La pasada se agotó contra la poda de MovePath::MAX_DEPTH: se
+            // reintenta con menos peso, hasta la pasada sin peso
+            weight = 1.0 + (weight - 1.0) / 2;
+            if (weight < ANYTIME_MIN_WEIGHT)
+                weight = 1.0;
+            continue;
+        }
+        if (passStats.status != SolveStatus::Solved) {
+            // Sin solución con costLimit: no las hay más cortas que la actual
+            if (passStats.status == SolveStatus::NoSolution && solved)
+                lowerBound = (int)best.size();
+            break;
+        }
+        // Con costLimit la solución nueva siempre es más corta
+        best = moves;
+        solved = true;
+        if (lowerBound >= (int)best.size() || weight <= 1.0)
+            break;
+        // Siguiente peso por debajo del factor ya probado
+        double proven = (double)best.size() / lowerBound;
+        do {
+            weight = 1.0 + (weight - 1.0) / 2;
+        } while (weight >= proven && weight >= ANYTIME_MIN_WEIGHT);
+        if (weight < ANYTIME_MIN_WEIGHT)
+            weight = 1.0;
+    }
+
+    stats->nodes = nodes;
+    stats->bound = lowerBound;
+    if (!solved)
+        return vector<pair<int,int>>();
+    stats->bound = lowerBound = min(lowerBound, (int)best.size());
+    stats->status = SolveStatus::Solved;
+    stats->suboptimality = lowerBound > 0 && (int)best.size() > lowerBound ? (double)best.size() / lowerBound : 1.0;
+    return best;
+}
@@ -0,0 +1,36 @@
+// anytime.h
+// Resolución anytime: una solución rápida con IDA* con peso que se mejora
+// hasta agotar el tiempo o probar que es óptima.
+#pragma once
+
+#include "ida_star.h"
+#include "pattern_db.h"
+#include "puzzle.h"
+
+#include <utility>
+#include <vector>
+
+// ------------------------------------------------------
+// Pasadas de IDA* con peso decreciente: la primera usa options.weight (o
+// ANYTIME_START_WEIGHT si es 1), como mucho el que deja w·Manhattan dentro
+// de MovePath::MAX_DEPTH, y cada una divide a la mitad el exceso sobre 1
+// hasta terminar sin peso. Ese tope no garantiza que la solución quepa (con
+// peso mide hasta w·C*, y C* puede superar con creces a Manhattan): una
+// pasada que termina sin solución por la poda de profundidad se repite con
+// un peso menor. Desde que hay solución, cada pasada busca solo
+// soluciones más cortas (SearchOptions::costLimit), así que terminar sin
+// solución prueba que la actual es óptima; también se para cuando la mejor
+// cota inferior alcanza su longitud. Se saltan los pesos que no mejoran el
+// factor ya probado.
+// options.limits son para toda la resolución: cada pasada recibe el tiempo y
+// los nodos que quedan. Si un límite la detiene con una solución en la mano
+// el resultado es Solved con la mejor encontrada; stats->bound es la mejor
+// cota inferior del óptimo y stats->suboptimality longitud / cota.
+// Los tableros 4x4 con db usan el motor 4x4 (opciones de iterativeIDAStar);
+// el resto, solveGrid con db si es de su tamaño.
+// ------------------------------------------------------
+const double ANYTIME_START_WEIGHT = 3.0;
+
+std::vector<std::pair<int,int>> anytimeSolve(const Puzzle &puzzle, const PatternDatabase* db,
+                                             const SearchOptions &options = SearchOptions(),
+                                             SearchStats* stats = nullptr);
@@ -0,0 +1,94 @@
+// batch.cpp
+
+#include "batch.h"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+
+using namespace std;
+
+string solveStatusMessage(SolveStatus status) {
+    switch (status) {
+        case SolveStatus::Solved: return "";
+        case SolveStatus::InvalidInput: return "Error: Tablero inválido.";
+        case SolveStatus::Unsolvable: return "Error: El tablero no tiene solución.";
+        case SolveStatus::Cancelled: return "Error: Resolución cancelada.";
+        case SolveStatus::Timeout: return "Error: Se agotó el tiempo de resolución.";
+        case SolveStatus::BudgetExhausted: return "Error: Se agotó el presupuesto de nodos.";
+        default: return "Error: no se encontró solución.";
+    }
+}
+
+BatchResult solveOne(const Puzzle &puzzle, const PatternDatabase &db, const SearchOptions &options) {
+    BatchResult result;
+    auto start = chrono::steady_clock::now();
+    result.status = checkBoard(puzzle);
+    if (result.status != SolveStatus::Solved) {
+        result.error = solveStatusMessage(result.status);
+        return result;
+    }
+    SearchBudget budget(options.limits);
+    IDAStarEngine engine(PackedState::fromPuzzle(puzzle), db, options);
+    engine.setBudget(&budget);
+    unique_ptr<TranspositionTable> table;
+    if (options.transpositionEntries > 0) {
+        table.reset(new TranspositionTable(options.transpositionEntries));
+        engine.setTranspositionTable(table.get());
+    }
+    result.status = engine.solve();
+    if (result.status == SolveStatus::Solved) {
+        const MovePath &path = engine.path();
+        for (int m = 0; m < path.length; m++){
+            result.moves.push_back(MOVE_LETTERS[path.at(m)]);
+        }
+        result.suboptimality = engine.suboptimality();
+    } else {
+        result.error = solveStatusMessage(result.status);
+    }
+    result.nodes = engine.generatedNodes();
+    result.bound = engine.lastBound();
+    result.micros = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+// ------------------------------------------------------
+// Resolución por lotes: N tableros repartidos en el pool compartido con una
+// sola PatternDB. Cada tablero se resuelve con el motor secuencial en un
+// hilo del pool (sin crear hilos ni recargar la PatternDB por tablero).
+// ------------------------------------------------------
+vector<BatchResult> runBatch(size_t count, WorkStealingPool &pool, const function<BatchResult(size_t)> &solveItem) {
+    vector<BatchResult> results(count);
+    if (count == 0)
+        return results;
+    TaskGroup group(count);
+    for (size_t i = 0; i < count; i++){
+        pool.submit((int)(i % (size_t)pool.threadCount()), [&, i] {
+            results[i] = solveItem(i);
+            group.done();
+        });
+    }
+    group.wait();
+    return results;
+}
+
+vector<BatchResult> solveBatch(const vector<string>& inputs, const PatternDatabase &db, WorkStealingPool &pool,
+                               const SearchOptions &options) {
+    return runBatch(inputs.size(), pool, [&](size_t i) {
+        auto start = chrono::steady_clock::now();
+        Puzzle puzzle(4);
+        BatchResult result;
+        if (parsePuzzle(inputs[i], puzzle, result.error))
+            return solveOne(puzzle, db, options);
+        result.status = SolveStatus::InvalidInput;
+        result.micros = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+        return result;
+    });
+}
+
+vector<BatchResult> solveBatch(const vector<Puzzle>& puzzles, const PatternDatabase &db, WorkStealingPool &pool,
+                               const SearchOptions &options) {
+    return runBatch(puzzles.size(), pool, [&](size_t i) {
+        return solveOne(puzzles[i], db, options);
+    });
+}
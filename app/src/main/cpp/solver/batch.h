@@ -0,0 +1,38 @@
+// batch.h
+// Resolución por lotes sobre el pool compartido con una sola PatternDB.
+#pragma once
+
+#include "ida_star.h"
+#include "pattern_db.h"
+#include "puzzle.h"
+#include "thread_pool.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct BatchResult {
+    SolveStatus status = SolveStatus::NoSolution;
+    std::string error;      // mensaje si no se pudo resolver
+    std::string moves;      // una letra de MOVE_LETTERS por movimiento
+    uint64_t nodes = 0;     // nodos generados
+    int bound = 0;          // cota inferior de la longitud óptima (último límite de f sin peso)
+    double suboptimality = 1.0; // factor probado respecto al óptimo (options.weight > 1)
+    int64_t micros = 0;     // tiempo de resolución de este tablero
+};
+
+// Mensaje de error para un estado distinto de Solved
+std::string solveStatusMessage(SolveStatus status);
+
+// Resuelve un tablero con el motor secuencial en el hilo actual. Los
+// tableros inválidos o sin solución se rechazan antes de buscar; si un
+// límite de options.limits detiene la búsqueda, nodes y bound son parciales.
+// En un lote cada tablero reserva su propia tabla de transposiciones.
+BatchResult solveOne(const Puzzle &puzzle, const PatternDatabase &db, const SearchOptions &options = SearchOptions());
+
+// Tableros en el formato de parsePuzzle; los que no se pueden parsear
+// devuelven el error de parsePuzzle
+std::vector<BatchResult> solveBatch(const std::vector<std::string>& inputs, const PatternDatabase &db, WorkStealingPool &pool,
+                                    const SearchOptions &options = SearchOptions());
+std::vector<BatchResult> solveBatch(const std::vector<Puzzle>& puzzles, const PatternDatabase &db, WorkStealingPool &pool,
+                                    const SearchOptions &options = SearchOptions());
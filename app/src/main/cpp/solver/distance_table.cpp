@@ -0,0 +1,302 @@
+// distance_table.cpp
+
+#include "distance_table.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+
+using namespace std;
+
+uint64_t factorial(int n) {
+    return permutationCount(n, n);
+}
+
+DistanceTable::DistanceTable(int rows, int cols) : rows(rows), cols(cols), entries(factorial(rows * cols) / 2) {}
+
+// ------------------------------------------------------
+// Estados completos: positions[t] = celda de la ficha t, board[celda] = ficha
+// ------------------------------------------------------
+struct FullState {
+    int positions[DISTANCE_TABLE_MAX_CELLS];
+    int board[DISTANCE_TABLE_MAX_CELLS];
+};
+
+// Paridad de la permutación celda -> celda objetivo de su ficha (como isSolvable)
+bool fullStateSolvable(const FullState &state, int rows, int cols) {
+    int cells = rows * cols, cycles = 0;
+    uint32_t visited = 0;
+    for (int cell = 0; cell < cells; cell++){
+        if (visited & (1u << cell))
+            continue;
+        cycles++;
+        for (int c = cell; !(visited & (1u << c)); ){
+            visited |= 1u << c;
+            int tile = state.board[c];
+            c = tile == 0 ? cells - 1 : tile - 1;
+        }
+    }
+    int blank = state.positions[0];
+    int blankDistance = (rows - 1 - blank / cols) + (cols - 1 - blank % cols);
+    return ((cells - cycles) & 1) == (blankDistance & 1);
+}
+
+// Inversa de DistanceTable::indexOf: coloca las dos últimas fichas en el orden con solución
+void unrankFullState(uint64_t index, int rows, int cols, FullState &state) {
+    int cells = rows * cols;
+    unrankPattern(index, cells - 2, cells, state.positions);
+    uint32_t used = 0;
+    for (int t = 0; t < cells - 2; t++){
+        used |= 1u << state.positions[t];
+        state.board[state.positions[t]] = t;
+    }
+    uint32_t free = ~used & ((1u << cells) - 1);
+    int first = __builtin_ctz(free), second = 31 - __builtin_clz(free);
+    state.positions[cells - 2] = first;
+    state.positions[cells - 1] = second;
+    state.board[first] = cells - 2;
+    state.board[second] = cells - 1;
+    if (!fullStateSolvable(state, rows, cols)) {
+        swap(state.positions[cells - 2], state.positions[cells - 1]);
+        state.board[first] = cells - 1;
+        state.board[second] = cells - 2;
+    }
+}
+
+// Vecino del hueco en la dirección dirIndex de Puzzle::DIRECTIONS, o -1
+int neighborCell(int cell, int dirIndex, int rows, int cols) {
+    int row = cell / cols + Puzzle::DIRECTIONS[dirIndex].first;
+    int col = cell % cols + Puzzle::DIRECTIONS[dirIndex].second;
+    if (row < 0 || row >= rows || col < 0 || col >= cols)
+        return -1;
+    return row * cols + col;
+}
+
+// Mueve el hueco a target; repetirlo con la celda anterior lo deshace
+void moveBlank(FullState &state, int target) {
+    int blank = state.positions[0];
+    int tile = state.board[target];
+    state.board[blank] = tile;
+    state.positions[tile] = blank;
+    state.board[target] = 0;
+    state.positions[0] = target;
+}
+
+// ------------------------------------------------------
+// BFS por niveles sobre la tabla: cada nivel expande solo su frontera, un
+// bitmap con las entradas que asignó el nivel anterior (un bit por entrada,
+// dos bitmaps), así que cada estado se expande una sola vez y el recorrido
+// de la frontera salta las palabras vacías. Los hijos sin valor reciben el
+// residuo del nivel siguiente y pasan a la frontera nueva; el nivel que no
+// asigna ninguna entrada termina el BFS.
+// ------------------------------------------------------
+shared_ptr<DistanceTable> DistanceTable::build(int rows, int cols) {
+    int cells = rows * cols;
+    if (rows < MIN_BOARD_SIDE || cols < MIN_BOARD_SIDE || cells > DISTANCE_TABLE_MAX_CELLS)
+        return nullptr;
+    auto table = make_shared<DistanceTable>(rows, cols);
+    table->owned.assign(table->byteSize(), 0xFF);
+    table->packed = table->owned.data();
+    uint8_t* data = table->owned.data();
+    auto setValue = [data](uint64_t index, uint8_t value) {
+        int shift = (int)(index & 1) << 2;
+        data[index >> 1] = (uint8_t)((data[index >> 1] & ~(0xF << shift)) | (value << shift));
+    };
+
+    FullState goal;
+    for (int cell = 0; cell < cells; cell++){
+        int tile = cell == cells - 1 ? 0 : cell + 1;
+        goal.board[cell] = tile;
+        goal.positions[tile] = cell;
+    }
+    uint64_t goalIndex = table->indexOf(goal.positions);
+    setValue(goalIndex, 0);
+
+    size_t words = (size_t)((table->entries + 63) / 64);
+    vector<uint64_t> frontier(words, 0), nextFrontier(words, 0);
+    frontier[goalIndex >> 6] |= 1ULL << (goalIndex & 63);
+    FullState state;
+    for (int depth = 0; ; depth++){
+        uint8_t next = (uint8_t)((depth + 1) % DISTANCE_MODULUS);
+        uint64_t assigned = 0;
+        for (size_t word = 0; word < words; word++){
+            for (uint64_t bits = frontier[word]; bits != 0; bits &= bits - 1){
+                uint64_t index = ((uint64_t)word << 6) | (uint64_t)__builtin_ctzll(bits);
+                unrankFullState(index, rows, cols, state);
+                int blank = state.positions[0];
+                for (int dir = 0; dir < 4; dir++){
+                    int target = neighborCell(blank, dir, rows, cols);
+                    if (target < 0)
+                        continue;
+                    moveBlank(state, target);
+                    uint64_t child = table->indexOf(state.positions);
+                    if (table->valueAt(child) == DISTANCE_UNKNOWN) {
+                        setValue(child, next);
+                        nextFrontier[child >> 6] |= 1ULL << (child & 63);
+                        assigned++;
+                    }
+                    moveBlank(state, blank);
+                }
+            }
+        }
+        if (assigned == 0)
+            break;
+        frontier.swap(nextFrontier);
+        fill(nextFrontier.begin(), nextFrontier.end(), 0);
+    }
+    return table;
+}
+
+bool DistanceTable::solve(const Puzzle &puzzle, vector<pair<int,int>> &moves) const {
+    moves.clear();
+    int cells = rows * cols;
+    if (puzzle.rows != rows || puzzle.cols != cols || !hasValidTiles(puzzle) || !isSolvable(puzzle))
+        return false;
+    FullState state;
+    for (int cell = 0; cell < cells; cell++){
+        int tile = puzzle.board[cell / cols][cell % cols];
+        state.board[cell] = tile;
+        state.positions[tile] = cell;
+    }
+    uint8_t value = valueAt(indexOf(state.positions));
+    if (value == DISTANCE_UNKNOWN)
+        return false;
+    while (true) {
+        bool goal = true;
+        for (int cell = 0; cell < cells - 1 && goal; cell++){
+            goal = state.board[cell] == cell + 1;
+        }
+        if (goal)
+            return true;
+        // Exactamente los vecinos a distancia d - 1 tienen este residuo
+        uint8_t wanted = (uint8_t)((value + DISTANCE_MODULUS - 1) % DISTANCE_MODULUS);
+        int blank = state.positions[0];
+        int chosen = -1;
+        for (int dir = 0; dir < 4 && chosen < 0; dir++){
+            int target = neighborCell(blank, dir, rows, cols);
+            if (target < 0)
+                continue;
+            moveBlank(state, target);
+            if (valueAt(indexOf(state.positions)) == wanted)
+                chosen = dir;
+            else
+                moveBlank(state, blank);
+        }
+        if (chosen < 0)
+            return false; // Tabla incompleta o corrupta
+        moves.push_back(Puzzle::DIRECTIONS[chosen]);
+        value = wanted;
+    }
+}
+
+// ------------------------------------------------------
+// Formato binario de tabla de distancias (versión 1, little-endian)
+//   DistanceFileHeader | tabla (2 entradas por byte, la par en el nibble bajo)
+// ------------------------------------------------------
+const char DISTANCE_MAGIC[4] = { 'D', 'S', 'T', 'N' };
+const uint16_t DISTANCE_FORMAT_VERSION = 1;
+
+struct DistanceFileHeader {
+    char magic[4];
+    uint16_t version;
+    uint8_t rows;
+    uint8_t cols;
+    uint8_t entryBits;      // bits por entrada (4)
+    uint8_t modulus;        // DISTANCE_MODULUS
+    uint16_t reserved0;
+    uint32_t checksum;      // FNV-1a de la tabla
+    uint64_t entryCount;
+    uint64_t fileSize;
+    uint8_t reserved1[32];
+};
+
+static_assert(sizeof(DistanceFileHeader) == 64, "DistanceFileHeader debe ocupar 64 bytes");
+
+bool writeDistanceTable(const DistanceTable &table, const string &path) {
+    DistanceFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, DISTANCE_MAGIC, sizeof(DISTANCE_MAGIC));
+    header.version = DISTANCE_FORMAT_VERSION;
+    header.rows = (uint8_t)table.rows;
+    header.cols = (uint8_t)table.cols;
+    header.entryBits = 4;
+    header.modulus = DISTANCE_MODULUS;
+    header.checksum = fnv1a(table.data(), table.byteSize());
+    header.entryCount = table.entries;
+    header.fileSize = sizeof(header) + table.byteSize();
+
+    ofstream out(path, ios::binary | ios::trunc);
+    if (!out.is_open())
+        return false;
+    out.write((const char*)&header, sizeof(header));
+    out.write((const char*)table.data(), (streamsize)table.byteSize());
+    return out.good();
+}
+
+shared_ptr<DistanceTable> parseDistanceTable(unique_ptr<PdbBlob> blob, int rows, int cols, bool verifyChecksum) {
+    if (!blob || blob->size() < sizeof(DistanceFileHeader))
+        return nullptr;
+    DistanceFileHeader header;
+    memcpy(&header, blob->data(), sizeof(header));
+    if (memcmp(header.magic, DISTANCE_MAGIC, sizeof(DISTANCE_MAGIC)) != 0
+        || header.version != DISTANCE_FORMAT_VERSION
+        || header.rows != rows || header.cols != cols
+        || rows * cols > DISTANCE_TABLE_MAX_CELLS
+        || header.entryBits != 4
+        || header.modulus != DISTANCE_MODULUS
+        || header.fileSize != blob->size())
+        return nullptr;
+    auto table = make_shared<DistanceTable>(rows, cols);
+    if (header.entryCount != table->entries || header.fileSize != sizeof(header) + table->byteSize())
+        return nullptr;
+    table->packed = blob->data() + sizeof(header);
+    if (verifyChecksum && fnv1a(table->packed, table->byteSize()) != header.checksum)
+        return nullptr;
+    table->blob = std::move(blob);
+    return table;
+}
+
+bool generateDistanceTableFile(int rows, int cols, const string &outPath) {
+    shared_ptr<DistanceTable> table = DistanceTable::build(rows, cols);
+    return table && writeDistanceTable(*table, outPath);
+}
+
+string distanceTableName(int rows, int cols) {
+    return "distance_" + to_string(rows) + "x" + to_string(cols) + ".dst";
+}
+
+// ------------------------------------------------------
+// Registro de tablas de distancia del proceso
+// ------------------------------------------------------
+mutex g_distanceTableMutex;
+map<pair<int,int>, shared_ptr<const DistanceTable>> g_distanceTables;
+
+// Tabla registrada del tamaño; la primera consulta busca el archivo y, con
+// build, se genera si no lo hay
+shared_ptr<const DistanceTable> registeredDistanceTable(int rows, int cols, bool build) {
+    if (rows < MIN_BOARD_SIDE || cols < MIN_BOARD_SIDE || rows * cols > DISTANCE_TABLE_MAX_CELLS)
+        return nullptr;
+    // La carga o la generación ocurre bajo el mutex: llamadas concurrentes esperan a la primera
+    lock_guard<mutex> lock(g_distanceTableMutex);
+    auto key = make_pair(rows, cols);
+    auto it = g_distanceTables.find(key);
+    if (it != g_distanceTables.end() && (it->second || !build))
+        return it->second;
+    shared_ptr<const DistanceTable> table;
+    if (it == g_distanceTables.end())
+        table = parseDistanceTable(openPdbSource(distanceTableName(rows, cols)), rows, cols, false);
+    if (!table && build && rows * cols <= DISTANCE_TABLE_BUILD_MAX_CELLS)
+        table = DistanceTable::build(rows, cols);
+    g_distanceTables[key] = table; // también nullptr: no se reintenta cada resolución
+    return table;
+}
+
+shared_ptr<const DistanceTable> distanceTableFor(int rows, int cols) {
+    return registeredDistanceTable(rows, cols, false);
+}
+
+bool preloadDistanceTable(int rows, int cols) {
+    return registeredDistanceTable(rows, cols, true) != nullptr;
+}
@@ -0,0 +1,94 @@
+// distance_table.h
+// Tablas de distancia exacta de todo el espacio de estados para tableros de
+// hasta DISTANCE_TABLE_MAX_CELLS celdas (3x3, 2x4, 2x5, 3x4...): BFS desde el
+// objetivo, 4 bits por estado y resolución por descenso voraz.
+#pragma once
+
+#include "pattern_db.h"
+#include "puzzle.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+const int DISTANCE_TABLE_MAX_CELLS = 12;
+// Tamaños que preloadDistanceTable genera si no hay archivo (2x5: 1.8M
+// estados, ~0.5 s)
+const int DISTANCE_TABLE_BUILD_MAX_CELLS = 10;
+
+// ------------------------------------------------------
+// Índice de un estado: rankPattern de las celdas de las fichas 0 (hueco) a
+// n-3. Las fichas n-2 y n-1 ocupan las dos celdas restantes en el único
+// orden con solución, así que los n!/2 estados alcanzables tienen índices
+// densos en [0, n!/2).
+// Cada entrada guarda la distancia mód DISTANCE_MODULUS (DISTANCE_UNKNOWN
+// sin dato): los vecinos están siempre a distancia d - 1 o d + 1, así que
+// el residuo basta para descender y 4 bits alcanzan para cualquier tamaño.
+// ------------------------------------------------------
+const uint8_t DISTANCE_MODULUS = 15;
+const uint8_t DISTANCE_UNKNOWN = 0xF;
+
+class DistanceTable {
+public:
+    int rows, cols;
+    uint64_t entries;   // n!/2
+
+    DistanceTable(int rows, int cols);
+
+    // Tabla completa por BFS desde el objetivo, sin cola: la frontera de
+    // cada nivel es un bitmap (además de la tabla, 2 bits por entrada). 3x4
+    // tarda alrededor de minuto y medio en un núcleo.
+    static std::shared_ptr<DistanceTable> build(int rows, int cols);
+
+    uint8_t valueAt(uint64_t index) const {
+        return (uint8_t)((packed[index >> 1] >> ((index & 1) << 2)) & 0xF);
+    }
+
+    // positions[t] = celda de la ficha t (0 = hueco)
+    uint64_t indexOf(const int* positions) const {
+        return rankPattern(positions, rows * cols - 2, rows * cols);
+    }
+
+    // Camino óptimo por descenso voraz: O(longitud) consultas. false si el
+    // tablero no es de este tamaño o no tiene solución.
+    bool solve(const Puzzle &puzzle, std::vector<std::pair<int,int>> &moves) const;
+
+    const uint8_t* data() const {
+        return packed;
+    }
+
+    size_t byteSize() const {
+        return (size_t)((entries + 1) / 2);
+    }
+
+private:
+    const uint8_t* packed = nullptr;    // apunta a owned o a blob
+    std::vector<uint8_t> owned;
+    std::unique_ptr<PdbBlob> blob;
+
+    friend std::shared_ptr<DistanceTable> parseDistanceTable(std::unique_ptr<PdbBlob> blob, int rows, int cols,
+                                                             bool verifyChecksum);
+};
+
+// Formato binario (ver distance_table.cpp); la tabla se usa desde la memoria mapeada
+bool writeDistanceTable(const DistanceTable &table, const std::string &path);
+std::shared_ptr<DistanceTable> parseDistanceTable(std::unique_ptr<PdbBlob> blob, int rows, int cols,
+                                                  bool verifyChecksum);
+
+// Genera la tabla de rows x cols y la escribe en outPath
+bool generateDistanceTableFile(int rows, int cols, const std::string &outPath);
+
+// Nombre del archivo que busca distanceTableFor: "distance_<rows>x<cols>.dst"
+std::string distanceTableName(int rows, int cols);
+
+// Registro del proceso: la tabla cargada con openPdbSource(distanceTableName)
+// o la que generó preloadDistanceTable. nullptr si el tamaño no tiene tabla.
+// No genera tablas: el BFS no respeta los límites de una resolución.
+std::shared_ptr<const DistanceTable> distanceTableFor(int rows, int cols);
+
+// Deja la tabla del tamaño en el registro: la del archivo o, si no hay y el
+// tablero tiene como mucho DISTANCE_TABLE_BUILD_MAX_CELLS celdas, generada.
+// false si el tamaño no tiene tabla.
+bool preloadDistanceTable(int rows, int cols);
@@ -0,0 +1,375 @@
+// grid_solver.cpp
+
+#include "grid_solver.h"
+#include "distance_table.h"
+
+using namespace std;
+
+template <int R, int C>
+GridEngine<R, C>::GridEngine(const Puzzle &puzzle, const PatternDatabase* patternDb, const SearchOptions &options)
+        : rowLines(LinearConflictTable::forSide(C)), colLines(LinearConflictTable::forSide(R)), cost(options.weight),
+          costLimit(options.costLimit > 0 ? min(options.costLimit, MovePath::MAX_DEPTH) : MovePath::MAX_DEPTH) {
+    for (int row = 0; row < R; row++){
+        rowCodes[row] = rowLines.emptyCode;
+    }
+    for (int col = 0; col < C; col++){
+        colCodes[col] = colLines.emptyCode;
+    }
+    for (int cell = 0; cell < Shape::CELLS; cell++){
+        int tile = puzzle.board[cell / C][cell % C];
+        tiles[cell] = (uint8_t)tile;
+        if (tile == 0) {
+            blank = cell;
+            continue;
+        }
+        int goal = tile - 1;
+        manhattan += Shape::MANHATTAN[tile][cell];
+        if (cell / C == goal / C)
+            rowCodes[cell / C] += rowLines.codeDelta(cell % C, goal % C, 1);
+        if (cell % C == goal % C)
+            colCodes[cell % C] += colLines.codeDelta(cell / C, goal / C, 1);
+    }
+    for (int row = 0; row < R; row++){
+        conflicts += rowLines.conflicts[rowCodes[row]];
+    }
+    for (int col = 0; col < C; col++){
+        conflicts += colLines.conflicts[colCodes[col]];
+    }
+
+    if (patternDb == nullptr || R != C || patternDb->boardSize != R)
+        return;
+    db = patternDb;
+    views = options.reflect ? 2 : 1;
+    fill(tileGroup, tileGroup + Shape::CELLS, (int8_t)-1);
+    for (size_t g = 0; g < db->groups.size(); g++){
+        for (int tile : db->groups[g].tiles){
+            tileGroup[tile] = (int8_t)g;
+        }
+    }
+    for (int cell = 0; cell < Shape::CELLS; cell++){
+        cellOf[0][tiles[cell]] = (uint8_t)cell;
+        cellOf[1][Shape::REFLECTION[1][tiles[cell]]] = Shape::REFLECTION[0][cell];
+    }
+    for (int view = 0; view < views; view++){
+        for (size_t g = 0; g < db->groups.size(); g++){
+            groupValue[view][g] = patternValue(view, (int)g, -1);
+            patternSum[view] += groupValue[view][g];
+        }
+    }
+}
+
+// Valor del grupo en la vista (0 si no hay tabla o falta la entrada). parent
+// es el valor antes del último movimiento, o -1 si no lo hay (raíz)
+template <int R, int C>
+int GridEngine<R, C>::patternValue(int view, int group, int parent) const {
+    const PatternGroup &pattern = db->groups[group];
+    if (pattern.table == nullptr)
+        return 0;
+    int positions[Shape::CELLS];
+    int k = (int)pattern.tiles.size();
+    for (int i = 0; i < k; i++){
+        positions[i] = cellOf[view][pattern.tiles[i]];
+    }
+    if (pattern.entryBits == PDB_ENCODING_MOD3 && parent < 0)
+        return mod3Distance(pattern, positions, R);
+    int groupManhattan = 0;
+    if (usesGroupManhattan(pattern)) {
+        for (int i = 0; i < k; i++){
+            groupManhattan += Shape::MANHATTAN[pattern.tiles[i]][positions[i]];
+        }
+    }
+    return ::patternValue(pattern, rankPattern(positions, k, Shape::CELLS), groupManhattan, 0, parent);
+}
+
+// Evalúa la PDB tras el último movimiento: solo cambia el grupo de la
+// ficha movida en cada vista. save guarda los valores anteriores.
+template <int R, int C>
+void GridEngine<R, C>::updatePattern(PatternSave &save) {
+    for (int view = 0; view < views; view++){
+        int tile = view == 0 ? movedTile : Shape::REFLECTION[1][movedTile];
+        int g = tileGroup[tile];
+        save.group[view] = (int8_t)g;
+        if (g < 0)
+            continue;
+        save.value[view] = groupValue[view][g];
+        int value = patternValue(view, g, save.value[view]);
+        patternSum[view] += value - save.value[view];
+        groupValue[view][g] = value;
+    }
+}
+
+template <int R, int C>
+void GridEngine<R, C>::restorePattern(const PatternSave &save) {
+    for (int view = 0; view < views; view++){
+        int g = save.group[view];
+        if (g < 0)
+            continue;
+        patternSum[view] += save.value[view] - groupValue[view][g];
+        groupValue[view][g] = save.value[view];
+    }
+}
+
+// Mueve el hueco; el movimiento contrario lo deshace exactamente
+template <int R, int C>
+void GridEngine<R, C>::makeMove(int dir) {
+    int target = Shape::NEIGHBORS[blank][dir];
+    int tile = tiles[target];
+    tiles[blank] = (uint8_t)tile;
+    tiles[target] = 0;
+    moveTile(tile, target, blank);
+    blank = target;
+}
+
+// La ficha tile pasa de from a to: actualiza Manhattan y las líneas afectadas
+template <int R, int C>
+void GridEngine<R, C>::moveTile(int tile, int from, int to) {
+    // Los valores de la PDB se actualizan aparte (updatePattern)
+    movedTile = tile;
+    cellOf[0][tile] = (uint8_t)to;
+    cellOf[1][Shape::REFLECTION[1][tile]] = Shape::REFLECTION[0][to];
+    manhattan += Shape::MANHATTAN[tile][to] - Shape::MANHATTAN[tile][from];
+    int goal = tile - 1, goalRow = goal / C, goalCol = goal % C;
+    int fromRow = from / C, fromCol = from % C, toRow = to / C, toCol = to % C;
+    if (fromRow != toRow) {
+        // Cambia de fila y de posición dentro de su columna
+        if (goalRow == fromRow) {
+            conflicts -= rowLines.conflicts[rowCodes[fromRow]];
+            rowCodes[fromRow] += rowLines.codeDelta(fromCol, goalCol, -1);
+            conflicts += rowLines.conflicts[rowCodes[fromRow]];
+        }
+        if (goalRow == toRow) {
+            conflicts -= rowLines.conflicts[rowCodes[toRow]];
+            rowCodes[toRow] += rowLines.codeDelta(toCol, goalCol, 1);
+            conflicts += rowLines.conflicts[rowCodes[toRow]];
+        }
+        if (goalCol == fromCol) {
+            conflicts -= colLines.conflicts[colCodes[fromCol]];
+            colCodes[fromCol] += colLines.codeDelta(fromRow, goalRow, -1) + colLines.codeDelta(toRow, goalRow, 1);
+            conflicts += colLines.conflicts[colCodes[fromCol]];
+        }
+    } else {
+        // Cambia de columna y de posición dentro de su fila
+        if (goalCol == fromCol) {
+            conflicts -= colLines.conflicts[colCodes[fromCol]];
+            colCodes[fromCol] += colLines.codeDelta(fromRow, goalRow, -1);
+            conflicts += colLines.conflicts[colCodes[fromCol]];
+        }
+        if (goalCol == toCol) {
+            conflicts -= colLines.conflicts[colCodes[toCol]];
+            colCodes[toCol] += colLines.codeDelta(toRow, goalRow, 1);
+            conflicts += colLines.conflicts[colCodes[toCol]];
+        }
+        if (goalRow == fromRow) {
+            conflicts -= rowLines.conflicts[rowCodes[fromRow]];
+            rowCodes[fromRow] += rowLines.codeDelta(fromCol, goalCol, -1) + rowLines.codeDelta(toCol, goalCol, 1);
+            conflicts += rowLines.conflicts[rowCodes[fromRow]];
+        }
+    }
+}
+
+// Prepara el nivel depth. Con peso los hijos se prueban por Manhattan +
+// conflictos creciente: la búsqueda se vuelve casi voraz y encuentra antes
+// una solución; sin peso, en el orden de las direcciones.
+template <int R, int C>
+void GridEngine<R, C>::enterFrame(int depth) {
+    nextDir[depth] = 0;
+    childOrder[depth] = 0xE4; // 0, 1, 2, 3
+    if (!cost.weighted())
+        return;
+    int dirs[4], hs[4];
+    for (int dir = 0; dir < 4; dir++){
+        int h = INF;
+        if (Shape::NEIGHBORS[blank][dir] >= 0) {
+            makeMove(dir);
+            h = manhattan + conflicts;
+            makeMove(oppositeDirection(dir));
+        }
+        // Inserción ordenada (estable)
+        int i = dir;
+        for (; i > 0 && hs[i - 1] > h; i--){
+            dirs[i] = dirs[i - 1];
+            hs[i] = hs[i - 1];
+        }
+        dirs[i] = dir;
+        hs[i] = h;
+    }
+    childOrder[depth] = (uint8_t)(dirs[0] | (dirs[1] << 2) | (dirs[2] << 4) | (dirs[3] << 6));
+}
+
+template <int R, int C>
+SolveStatus GridEngine<R, C>::solve() {
+    solveBound = cost.f(0, heuristicValue());
+    while (true) {
+        if (budget != nullptr && !budget->charge(0))
+            return budget->reason();
+        if (progress)
+            progress(cost.lowerBound(solveBound), nodes);
+        int t = iterate(solveBound);
+        if (t == IDAStarEngine::FOUND)
+            return SolveStatus::Solved;
+        if (t == IDAStarEngine::ABORTED)
+            return budget != nullptr && budget->stopped() ? budget->reason() : SolveStatus::Cancelled;
+        // Como IDAStarEngine::solve: sin f por encima del límite no hay más
+        if (t == INF || t <= solveBound)
+            return SolveStatus::NoSolution;
+        solveBound = t;
+    }
+}
+
+template <int R, int C>
+int GridEngine<R, C>::iterate(int bound) {
+    movePath.length = 0;
+    if (heuristicValue() >= costLimit)
+        return INF;
+    if (cost.f(0, heuristicValue()) > bound)
+        return cost.f(0, heuristicValue());
+    if (heuristicValue() == 0)
+        return IDAStarEngine::FOUND;
+
+    int newBound = INF;
+    int depth = 0;
+    enterFrame(0);
+    while (depth >= 0) {
+        if (nextDir[depth] == 4) {
+            // Todos los hijos explorados: deshacer el movimiento que llevó aquí
+            if (depth == 0)
+                break;
+            restorePattern(saved[depth]);
+            makeMove(oppositeDirection(movePath.last()));
+            movePath.pop();
+            depth--;
+            continue;
+        }
+        int dir = (childOrder[depth] >> (nextDir[depth]++ << 1)) & 3;
+        // Evitar revertir el último movimiento
+        if (depth > 0 && dir == oppositeDirection(movePath.last()))
+            continue;
+        if (Shape::NEIGHBORS[blank][dir] < 0)
+            continue;
+
+        makeMove(dir);
+        if ((++nodes & (IDAStarEngine::STOP_CHECK_INTERVAL - 1)) == 0 && budget != nullptr
+            && !budget->charge(IDAStarEngine::STOP_CHECK_INTERVAL)) {
+            makeMove(oppositeDirection(dir));
+            for (; depth > 0; depth--){
+                restorePattern(saved[depth]);
+                makeMove(oppositeDirection(movePath.last()));
+                movePath.pop();
+            }
+            return IDAStarEngine::ABORTED;
+        }
+        // La PDB solo se consulta si Manhattan + conflictos no poda el hijo o
+        // si su f exacto puede bajar newBound (f nunca es menor que esta
+        // cota). Se descartan los hijos que no pueden llevar a una solución
+        // que quepa en MovePath o sea más corta que options.costLimit; no
+        // cuentan para newBound (ver IDAStarEngine::iterate).
+        int f = cost.f(depth + 1, manhattan + conflicts);
+        bool pruned = depth + 1 + manhattan + conflicts >= costLimit;
+        bool evaluated = !pruned && views > 0 && (f <= bound || f < newBound);
+        if (evaluated) {
+            updatePattern(saved[depth + 1]);
+            f = cost.f(depth + 1, heuristicValue());
+            pruned = depth + 1 + heuristicValue() >= costLimit;
+        }
+        if (pruned) {
+            if (evaluated)
+                restorePattern(saved[depth + 1]);
+            makeMove(oppositeDirection(dir));
+            continue;
+        }
+        if (f > bound) {
+            newBound = min(newBound, f);
+            if (evaluated)
+                restorePattern(saved[depth + 1]);
+            makeMove(oppositeDirection(dir));
+            continue;
+        }
+        movePath.push(dir);
+        // Manhattan 0 solo en el objetivo
+        if (manhattan == 0)
+            return IDAStarEngine::FOUND;
+        depth++;
+        enterFrame(depth);
+    }
+    return newBound;
+}
+
+// Instancias explícitas: todos los tamaños de 2x2 a 6x6, también rectangulares
+#define INSTANTIATE_GRID_ROW(R) \
+    template class GridEngine<R, 2>; \
+    template class GridEngine<R, 3>; \
+    template class GridEngine<R, 4>; \
+    template class GridEngine<R, 5>; \
+    template class GridEngine<R, 6>;
+
+INSTANTIATE_GRID_ROW(2)
+INSTANTIATE_GRID_ROW(3)
+INSTANTIATE_GRID_ROW(4)
+INSTANTIATE_GRID_ROW(5)
+INSTANTIATE_GRID_ROW(6)
+
+template <int R, int C>
+vector<pair<int,int>> solveGridShape(const Puzzle &puzzle, const PatternDatabase* db, const SearchOptions &options,
+                                     SearchStats* stats) {
+    SearchBudget budget(options.limits);
+    GridEngine<R, C> engine(puzzle, db, options);
+    engine.setBudget(&budget);
+    engine.setProgress(options.progress);
+    stats->status = engine.solve();
+    stats->nodes = engine.generatedNodes();
+    stats->bound = engine.lastBound();
+    if (stats->status != SolveStatus::Solved)
+        return vector<pair<int,int>>();
+    stats->suboptimality = engine.suboptimality();
+    return engine.path().toDirections();
+}
+
+using GridSolver = vector<pair<int,int>> (*)(const Puzzle&, const PatternDatabase*, const SearchOptions&, SearchStats*);
+
+#define GRID_SOLVER_ROW(R) \
+    { solveGridShape<R, 2>, solveGridShape<R, 3>, solveGridShape<R, 4>, solveGridShape<R, 5>, solveGridShape<R, 6> }
+
+// GRID_SOLVERS[rows - MIN_BOARD_SIDE][cols - MIN_BOARD_SIDE]
+const GridSolver GRID_SOLVERS[5][5] = {
+    GRID_SOLVER_ROW(2),
+    GRID_SOLVER_ROW(3),
+    GRID_SOLVER_ROW(4),
+    GRID_SOLVER_ROW(5),
+    GRID_SOLVER_ROW(6)
+};
+
+bool isGridSupported(int rows, int cols) {
+    return rows >= MIN_BOARD_SIDE && rows <= MAX_BOARD_SIDE && cols >= MIN_BOARD_SIDE && cols <= MAX_BOARD_SIDE;
+}
+
+SolveStatus checkGrid(const Puzzle &puzzle) {
+    if (!isGridSupported(puzzle.rows, puzzle.cols) || !hasValidTiles(puzzle))
+        return SolveStatus::InvalidInput;
+    if (!isSolvable(puzzle))
+        return SolveStatus::Unsolvable;
+    return SolveStatus::Solved;
+}
+
+vector<pair<int,int>> solveGrid(const Puzzle &puzzle, const PatternDatabase* db, const SearchOptions &options,
+                                SearchStats* stats) {
+    SearchStats local;
+    if (stats == nullptr)
+        stats = &local;
+    *stats = SearchStats();
+    stats->status = checkGrid(puzzle);
+    if (stats->status != SolveStatus::Solved)
+        return vector<pair<int,int>>();
+    // Tableros pequeños: descenso sobre la tabla de distancias exactas
+    shared_ptr<const DistanceTable> table = distanceTableFor(puzzle.rows, puzzle.cols);
+    vector<pair<int,int>> moves;
+    if (table && table->solve(puzzle, moves)) {
+        stats->nodes = 0;
+        stats->bound = (int)moves.size();
+        return moves;
+    }
+    return GRID_SOLVERS[puzzle.rows - MIN_BOARD_SIDE][puzzle.cols - MIN_BOARD_SIDE](puzzle, db, options, stats);
+}
+
+vector<pair<int,int>> solveGrid(const Puzzle &puzzle, const SearchOptions &options, SearchStats* stats) {
+    return solveGrid(puzzle, nullptr, options, stats);
+}
@@ -0,0 +1,191 @@
+// grid_solver.h
+// Solver para tableros rows x cols de MIN_BOARD_SIDE a MAX_BOARD_SIDE: estado,
+// tablas de movimientos y búsqueda especializados en tiempo de compilación
+// para cada tamaño, con selección de la instancia en tiempo de ejecución.
+#pragma once
+
+#include "ida_star.h"
+#include "linear_conflict.h"
+#include "pattern_db.h"
+#include "puzzle.h"
+#include "search_limits.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// ------------------------------------------------------
+// Tablas constexpr de un tablero R x C (objetivo: ficha t en la celda t - 1,
+// hueco en la última celda)
+// ------------------------------------------------------
+template <int R, int C>
+constexpr std::array<std::array<int8_t, 4>, R * C> gridNeighbors() {
+    std::array<std::array<int8_t, 4>, R * C> table{};
+    for (int cell = 0; cell < R * C; cell++){
+        int row = cell / C, col = cell % C;
+        table[cell][0] = (int8_t)(row + 1 < R ? cell + C : -1);   // abajo
+        table[cell][1] = (int8_t)(row > 0 ? cell - C : -1);       // arriba
+        table[cell][2] = (int8_t)(col + 1 < C ? cell + 1 : -1);   // derecha
+        table[cell][3] = (int8_t)(col > 0 ? cell - 1 : -1);       // izquierda
+    }
+    return table;
+}
+
+template <int R, int C>
+constexpr std::array<std::array<uint8_t, R * C>, R * C> gridManhattan() {
+    std::array<std::array<uint8_t, R * C>, R * C> table{};
+    for (int tile = 1; tile < R * C; tile++){
+        int goal = tile - 1;
+        for (int cell = 0; cell < R * C; cell++){
+            int rows = cell / C - goal / C, cols = cell % C - goal % C;
+            table[tile][cell] = (uint8_t)((rows < 0 ? -rows : rows) + (cols < 0 ? -cols : cols));
+        }
+    }
+    return table;
+}
+
+// Reflejo sobre la diagonal principal (solo tableros cuadrados; si no, identidad):
+// REFLECTION[0][celda] = celda traspuesta, REFLECTION[1][ficha] = ficha reetiquetada
+template <int R, int C>
+constexpr std::array<std::array<uint8_t, R * C>, 2> gridReflection() {
+    std::array<std::array<uint8_t, R * C>, 2> table{};
+    for (int cell = 0; cell < R * C; cell++){
+        table[0][cell] = (uint8_t)(R == C ? (cell % C) * C + cell / C : cell);
+    }
+    for (int tile = 1; tile < R * C; tile++){
+        table[1][tile] = (uint8_t)(table[0][tile - 1] + 1);
+    }
+    return table;
+}
+
+template <int R, int C>
+struct GridShape {
+    static constexpr int ROWS = R;
+    static constexpr int COLS = C;
+    static constexpr int CELLS = R * C;
+    // Celda vecina en cada dirección de Puzzle::DIRECTIONS, o -1 en el borde
+    static constexpr std::array<std::array<int8_t, 4>, CELLS> NEIGHBORS = gridNeighbors<R, C>();
+    // MANHATTAN[ficha][celda]: distancia de la celda a la celda objetivo de la ficha
+    static constexpr std::array<std::array<uint8_t, CELLS>, CELLS> MANHATTAN = gridManhattan<R, C>();
+    static constexpr std::array<std::array<uint8_t, CELLS>, 2> REFLECTION = gridReflection<R, C>();
+};
+
+// ------------------------------------------------------
+// Motor IDA* make/unmake para un tablero R x C con Manhattan + conflictos
+// lineales incrementales (filas de C celdas, columnas de R celdas). Todos
+// los tamaños se instancian explícitamente en grid_solver.cpp.
+// En tableros cuadrados acepta además una PatternDB aditiva del mismo lado
+// (p. ej. 6-6-6-6 en 5x5), opcionalmente también sobre el reflejo: cada
+// movimiento cambia el rango de un solo grupo por vista y h es el máximo de
+// Manhattan + conflictos y las sumas de la PDB. La PDB se consulta solo
+// para los hijos que Manhattan + conflictos no basta para podar. Las entradas PDB_MISSING y
+// los grupos sin tabla cuentan 0; la walking distance es solo de 4x4.
+// ------------------------------------------------------
+template <int R, int C>
+class GridEngine {
+public:
+    using Shape = GridShape<R, C>;
+
+    // puzzle debe ser R x C y válido (ver checkGrid); db se ignora si no es
+    // de un tablero R x R. De options se usan reflect, weight y costLimit,
+    // como en IDAStarEngine.
+    explicit GridEngine(const Puzzle &puzzle, const PatternDatabase* db = nullptr,
+                        const SearchOptions &options = SearchOptions());
+
+    // IDA* completo; como IDAStarEngine::solve
+    SolveStatus solve();
+
+    // Una iteración acotada: FOUND, ABORTED o el menor f que superó el límite
+    int iterate(int bound);
+
+    int heuristicValue() const {
+        return std::max(manhattan + conflicts, std::max(patternSum[0], patternSum[1]));
+    }
+
+    const MovePath& path() const {
+        return movePath;
+    }
+
+    uint64_t generatedNodes() const {
+        return nodes;
+    }
+
+    // Cota inferior de la longitud óptima según el último límite de solve()
+    int lastBound() const {
+        return cost.lowerBound(solveBound);
+    }
+
+    // Factor probado de path() respecto al óptimo tras resolver (1 sin peso)
+    double suboptimality() const {
+        return cost.suboptimality(movePath.length, solveBound);
+    }
+
+    void setBudget(SearchBudget* searchBudget) {
+        budget = searchBudget;
+    }
+
+    void setProgress(SearchProgress callback) {
+        progress = std::move(callback);
+    }
+
+private:
+    std::array<uint8_t, Shape::CELLS> tiles;
+    int blank;
+    int manhattan = 0;
+    int conflicts = 0;
+    uint32_t rowCodes[R];
+    uint32_t colCodes[C];
+    const LinearConflictTable &rowLines;    // líneas de C celdas
+    const LinearConflictTable &colLines;    // líneas de R celdas
+    // PatternDB: vista 0 directa, vista 1 reflejada (solo con reflect)
+    const PatternDatabase* db = nullptr;
+    int views = 0;
+    int8_t tileGroup[Shape::CELLS];
+    uint8_t cellOf[2][Shape::CELLS];        // celda de cada ficha en cada vista
+    int groupValue[2][Shape::CELLS];
+    int patternSum[2] = { 0, 0 };
+    int movedTile = 0;                      // ficha del último makeMove
+    // Valores de grupo anteriores a evaluar el hijo de cada profundidad
+    struct PatternSave {
+        int8_t group[2];
+        int value[2];
+    };
+    PatternSave saved[MovePath::MAX_DEPTH + 1];
+    WeightedCost cost;
+    int costLimit;                          // options.costLimit, como mucho MovePath::MAX_DEPTH
+    uint64_t nodes = 0;
+    int solveBound = 0;
+    SearchBudget* budget = nullptr;
+    SearchProgress progress;
+    MovePath movePath;
+    // Por nivel: direcciones en orden (2 bits cada una) y la siguiente
+    uint8_t childOrder[MovePath::MAX_DEPTH + 1];
+    uint8_t nextDir[MovePath::MAX_DEPTH + 1];
+
+    void enterFrame(int depth);
+    void makeMove(int dir);
+    void moveTile(int tile, int from, int to);
+    int patternValue(int view, int group, int parent) const;
+    void updatePattern(PatternSave &save);
+    void restorePattern(const PatternSave &save);
+};
+
+// Tamaño admitido por el solver genérico
+bool isGridSupported(int rows, int cols);
+
+// Comprobación previa a la búsqueda: Solved si el tamaño está admitido y el
+// tablero es válido y tiene solución
+SolveStatus checkGrid(const Puzzle &puzzle);
+
+// Resuelve cualquier tamaño admitido: por descenso sobre la tabla de
+// distancias si el tamaño tiene una (distanceTableFor; sin búsqueda,
+// stats->nodes es 0) y si no con la instancia de GridEngine que le corresponde, con db si es del mismo
+// tamaño. Respeta options.limits, options.progress, options.reflect,
+// options.weight y options.costLimit; la tabla de transposiciones, el orden de hijos y el
+// perímetro son del motor 4x4 y no se usan.
+std::vector<std::pair<int,int>> solveGrid(const Puzzle &puzzle, const PatternDatabase* db,
+                                          const SearchOptions &options = SearchOptions(), SearchStats* stats = nullptr);
+std::vector<std::pair<int,int>> solveGrid(const Puzzle &puzzle, const SearchOptions &options = SearchOptions(),
+                                          SearchStats* stats = nullptr);
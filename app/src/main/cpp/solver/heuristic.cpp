@@ -0,0 +1,21 @@
+// heuristic.cpp
+
+#include "heuristic.h"
+
+int manhattan(const PackedState &state, uint32_t mask) {
+    int h = 0;
+    uint64_t tiles = state.tiles;
+    for (int cell = 0; cell < PackedState::CELLS; cell++, tiles >>= 4){
+        int tile = (int)(tiles & 0xF);
+        if (tile != 0 && ((mask >> tile) & 1u)){
+            h += manhattanCost(tile, cell);
+        }
+    }
+    return h;
+}
+
+int hScore(const PackedState &state, const PatternDatabase &db, bool reflect) {
+    IncrementalHeuristic heuristic(db, reflect);
+    heuristic.reset(state);
+    return heuristic.value();
+}
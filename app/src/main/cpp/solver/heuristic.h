@@ -0,0 +1,329 @@
+// heuristic.h
+// Heurística aditiva de PatternDB (completa e incremental).
+#pragma once
+
+#include "pattern_db.h"
+#include "linear_conflict.h"
+#include "puzzle.h"
+#include "walking_distance.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+// ------------------------------------------------------
+// Funciones heurísticas
+// ------------------------------------------------------
+// Distancia Manhattan de una ficha en cell a su celda objetivo
+inline int manhattanCost(int tile, int cell) {
+    int dest = tile - 1;
+    return std::abs(dest / PackedState::SIDE - cell / PackedState::SIDE)
+           + std::abs(dest % PackedState::SIDE - cell % PackedState::SIDE);
+}
+
+// Suma de Manhattan de las fichas de mask (bit t = ficha t)
+int manhattan(const PackedState &state, uint32_t mask);
+
+// Valor de un grupo: entrada de la PDB o, si falta o no hay tabla, fallback
+// (Manhattan + conflictos lineales de las fichas del grupo). Las tablas
+// nibble y las comprimidas usan manhattan (el del grupo) y las mod 3 parent
+// (el valor del grupo antes del último movimiento).
+inline int patternValue(const PatternGroup &group, uint64_t rank, int manhattan, int fallback, int parent) {
+    if (group.table == nullptr)
+        return fallback;
+    if (group.entryBits == PDB_ENCODING_BYTE) {
+        if (group.compression == 1) {
+            uint8_t value = group.table[rank];
+            return value != PDB_MISSING ? value : fallback;
+        }
+        uint8_t value = group.table[rank / group.compression];
+        return value != PDB_MISSING ? value + ((manhattan - value) & 1) : fallback;
+    }
+    uint8_t code = patternCode(group, rank);
+    if (group.entryBits == PDB_ENCODING_MOD3)
+        return decodeMod3(parent, code);
+    return code != PDB_NIBBLE_MISSING ? manhattan + 2 * code : fallback;
+}
+
+inline uint64_t groupRank(const PatternGroup &group, const int* tileCell) {
+    int positions[PackedState::CELLS];
+    int k = (int)group.tiles.size();
+    for (int i = 0; i < k; i++){
+        positions[i] = tileCell[group.tiles[i]];
+    }
+    return rankPattern(positions, k, PackedState::CELLS);
+}
+
+// ------------------------------------------------------
+// Reflejo sobre la diagonal principal: el objetivo es simétrico, así que la
+// distancia del estado traspuesto (celda (f, c) -> (c, f), ficha t -> la
+// ficha cuyo objetivo es el traspuesto del de t) es la misma y la PDB
+// aplicada a él también es admisible.
+// ------------------------------------------------------
+struct Reflection {
+    int cell[PackedState::CELLS];   // celda traspuesta
+    int tile[PackedState::CELLS];   // ficha reetiquetada (el hueco queda en 0)
+
+    Reflection() {
+        for (int i = 0; i < PackedState::CELLS; i++){
+            cell[i] = (i % PackedState::SIDE) * PackedState::SIDE + i / PackedState::SIDE;
+        }
+        tile[0] = 0;
+        for (int t = 1; t < PackedState::CELLS; t++){
+            tile[t] = cell[t - 1] + 1;
+        }
+    }
+
+    static const Reflection& instance() {
+        static const Reflection reflection;
+        return reflection;
+    }
+
+    PackedState reflect(const PackedState &state) const {
+        PackedState reflected;
+        reflected.tiles = 0;
+        reflected.blank = cell[state.blank];
+        for (int c = 0; c < PackedState::CELLS; c++){
+            reflected.tiles |= (uint64_t)tile[state.tileAt(c)] << (cell[c] << 2);
+        }
+        return reflected;
+    }
+};
+
+// Valor completo de la heurística (igual a IncrementalHeuristic::value)
+int hScore(const PackedState &state, const PatternDatabase &db, bool reflect = false);
+
+// ------------------------------------------------------
+// Suma incremental de los grupos sobre una vista del tablero: cada
+// movimiento desplaza una sola ficha, así que solo cambia el rango y el
+// valor del grupo que la contiene. Los grupos que pueden necesitar el
+// fallback (tabla incompleta o sin tabla) mantienen además su Manhattan por
+// diferencia y los códigos de línea de los conflictos lineales; las tablas
+// nibble y las comprimidas, solo el Manhattan.
+// ------------------------------------------------------
+struct PatternUndo {
+    int group;          // -1 si la ficha no pertenece a ningún grupo
+    uint64_t rank;
+    int value;
+    int manhattan;
+};
+
+class PatternSum {
+public:
+    explicit PatternSum(const PatternDatabase &db)
+            : db(db), lines(LinearConflictTable::forSide(PackedState::SIDE)) {}
+
+    void reset(const PackedState &state) {
+        uint64_t tiles = state.tiles;
+        for (int cell = 0; cell < PackedState::CELLS; cell++, tiles >>= 4){
+            tileCell[tiles & 0xF] = cell;
+        }
+        std::fill(tileGroup, tileGroup + PackedState::CELLS, -1);
+        total = 0;
+        for (size_t g = 0; g < db.groups.size(); g++){
+            const auto &group = db.groups[g];
+            for (int tile : group.tiles){
+                tileGroup[tile] = (int)g;
+            }
+            tracked[g] = !group.complete;
+            measured[g] = tracked[g] || usesGroupManhattan(group);
+            groupManhattan[g] = measured[g] ? manhattan(state, group.mask) : 0;
+            conflicts[g] = 0;
+            if (tracked[g]) {
+                std::fill(rowCode[g], rowCode[g] + PackedState::SIDE, lines.emptyCode);
+                std::fill(colCode[g], colCode[g] + PackedState::SIDE, lines.emptyCode);
+                for (int tile : group.tiles){
+                    if (tile != 0)
+                        placeTile((int)g, tile, tileCell[tile], 1);
+                }
+            }
+            ranks[g] = group.table != nullptr ? groupRank(group, tileCell) : 0;
+            if (group.table != nullptr && group.entryBits == PDB_ENCODING_MOD3) {
+                int positions[PackedState::CELLS];
+                for (size_t i = 0; i < group.tiles.size(); i++){
+                    positions[i] = tileCell[group.tiles[i]];
+                }
+                values[g] = mod3Distance(group, positions, PackedState::SIDE);
+            } else {
+                values[g] = patternValue(group, ranks[g], groupManhattan[g], groupManhattan[g] + conflicts[g], 0);
+            }
+            total += values[g];
+        }
+    }
+
+    int value() const {
+        return total;
+    }
+
+    // Posición actual de cada ficha (inversa del estado)
+    const int* cells() const {
+        return tileCell;
+    }
+
+    // La ficha tile pasa de la celda from a la celda to
+    void moveTile(int tile, int from, int to, PatternUndo &undo) {
+        tileCell[tile] = to;
+        int g = tileGroup[tile];
+        undo.group = g;
+        if (g < 0)
+            return;
+        const auto &group = db.groups[g];
+        undo.rank = ranks[g];
+        undo.value = values[g];
+        if (measured[g]) {
+            undo.manhattan = groupManhattan[g];
+            groupManhattan[g] += manhattanCost(tile, to) - manhattanCost(tile, from);
+        }
+        if (tracked[g]) {
+            placeTile(g, tile, from, -1);
+            placeTile(g, tile, to, 1);
+        }
+        if (group.table != nullptr)
+            ranks[g] = groupRank(group, tileCell);
+        values[g] = patternValue(group, ranks[g], groupManhattan[g], groupManhattan[g] + conflicts[g], undo.value);
+        total += values[g] - undo.value;
+    }
+
+    void undoMove(int tile, int from, const PatternUndo &undo) {
+        int to = tileCell[tile];
+        tileCell[tile] = from;
+        int g = undo.group;
+        if (g < 0)
+            return;
+        total += undo.value - values[g];
+        ranks[g] = undo.rank;
+        values[g] = undo.value;
+        if (measured[g])
+            groupManhattan[g] = undo.manhattan;
+        if (tracked[g]) {
+            placeTile(g, tile, to, -1);
+            placeTile(g, tile, from, 1);
+        }
+    }
+
+private:
+    const PatternDatabase &db;
+    const LinearConflictTable &lines;
+    int tileCell[PackedState::CELLS];
+    int tileGroup[PackedState::CELLS];
+    uint64_t ranks[PackedState::CELLS];
+    int values[PackedState::CELLS];
+    int total = 0;
+    // Fallback de los grupos con tracked[g]; Manhattan también con measured[g]
+    bool tracked[PackedState::CELLS];
+    bool measured[PackedState::CELLS];
+    int groupManhattan[PackedState::CELLS];
+    int conflicts[PackedState::CELLS];
+    uint32_t rowCode[PackedState::CELLS][PackedState::SIDE];
+    uint32_t colCode[PackedState::CELLS][PackedState::SIDE];
+
+    // Pone (sign = 1) o quita (sign = -1) la ficha de los códigos de su fila
+    // y su columna si es su línea objetivo, actualizando los conflictos
+    void placeTile(int g, int tile, int cell, int sign) {
+        int goal = tile - 1;
+        int row = cell / PackedState::SIDE, col = cell % PackedState::SIDE;
+        int goalRow = goal / PackedState::SIDE, goalCol = goal % PackedState::SIDE;
+        if (goalRow == row) {
+            uint32_t &code = rowCode[g][row];
+            conflicts[g] -= lines.conflicts[code];
+            code += lines.codeDelta(col, goalCol, sign);
+            conflicts[g] += lines.conflicts[code];
+        }
+        if (goalCol == col) {
+            uint32_t &code = colCode[g][col];
+            conflicts[g] -= lines.conflicts[code];
+            code += lines.codeDelta(row, goalRow, sign);
+            conflicts[g] += lines.conflicts[code];
+        }
+    }
+};
+
+// ------------------------------------------------------
+// Heurística incremental completa: suma de la PDB sobre el estado y, con
+// reflect, también sobre su reflejo (se toma el máximo), combinada con la
+// walking distance si la PatternDB la pide. La walking distance avanza con
+// una transición por movimiento. Da el mismo resultado que hScore.
+// ------------------------------------------------------
+struct HeuristicUndo {
+    PatternUndo direct;
+    PatternUndo reflected;
+    int walkingRow;     // índices de walking distance antes del movimiento
+    int walkingCol;
+};
+
+class IncrementalHeuristic {
+public:
+    explicit IncrementalHeuristic(const PatternDatabase &db, bool reflect = false)
+            : direct(db), reflected(db), reflection(reflect && hasTables(db) ? &Reflection::instance() : nullptr),
+              walking(db.walkingDistance ? WalkingDistanceTable::forSide(PackedState::SIDE) : nullptr) {}
+
+    void reset(const PackedState &state) {
+        direct.reset(state);
+        if (reflection != nullptr)
+            reflected.reset(reflection->reflect(state));
+        if (walking != nullptr) {
+            const int* tileCell = direct.cells();
+            int rowCounts[PackedState::CELLS] = {};
+            int colCounts[PackedState::CELLS] = {};
+            for (int tile = 1; tile < PackedState::CELLS; tile++){
+                int cell = tileCell[tile], goal = tile - 1;
+                rowCounts[cell / PackedState::SIDE * PackedState::SIDE + goal / PackedState::SIDE]++;
+                colCounts[cell % PackedState::SIDE * PackedState::SIDE + goal % PackedState::SIDE]++;
+            }
+            walkingRow = walking->indexOf(rowCounts);
+            walkingCol = walking->indexOf(colCounts);
+        }
+    }
+
+    int value() const {
+        int h = direct.value();
+        if (reflection != nullptr)
+            h = std::max(h, reflected.value());
+        if (walking != nullptr)
+            h = std::max(h, walking->distance[walkingRow] + walking->distance[walkingCol]);
+        return h;
+    }
+
+    // La ficha tile pasa de la celda from a la celda to (el hueco, de to a from)
+    void moveTile(int tile, int from, int to, HeuristicUndo &undo) {
+        direct.moveTile(tile, from, to, undo.direct);
+        if (reflection != nullptr)
+            reflected.moveTile(reflection->tile[tile], reflection->cell[from], reflection->cell[to], undo.reflected);
+        if (walking != nullptr) {
+            undo.walkingRow = walkingRow;
+            undo.walkingCol = walkingCol;
+            int goal = tile - 1, backward = from < to ? 1 : 0;
+            if (from / PackedState::SIDE != to / PackedState::SIDE)
+                walkingRow = walking->next(walkingRow, backward, goal / PackedState::SIDE);
+            else
+                walkingCol = walking->next(walkingCol, backward, goal % PackedState::SIDE);
+        }
+    }
+
+    void undoMove(int tile, int from, const HeuristicUndo &undo) {
+        direct.undoMove(tile, from, undo.direct);
+        if (reflection != nullptr)
+            reflected.undoMove(reflection->tile[tile], reflection->cell[from], undo.reflected);
+        if (walking != nullptr) {
+            walkingRow = undo.walkingRow;
+            walkingCol = undo.walkingCol;
+        }
+    }
+
+private:
+    PatternSum direct;
+    PatternSum reflected;       // solo se usa con reflection
+    const Reflection* reflection;
+    const WalkingDistanceTable* walking;
+    int walkingRow = 0;
+    int walkingCol = 0;
+
+    // Manhattan + conflictos lineales es simétrico respecto al reflejo: sin
+    // tablas el reflejo no aporta nada
+    static bool hasTables(const PatternDatabase &db) {
+        for (const auto &group : db.groups){
+            if (group.table != nullptr)
+                return true;
+        }
+        return false;
+    }
+};
@@ -0,0 +1,184 @@
+// ida_star.cpp
+
+#include "ida_star.h"
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <memory>
+
+using namespace std;
+
+SolveStatus checkBoard(const Puzzle &puzzle) {
+    if (puzzle.rows != PackedState::SIDE || puzzle.cols != PackedState::SIDE || !hasValidTiles(puzzle))
+        return SolveStatus::InvalidInput;
+    if (!isSolvable(puzzle))
+        return SolveStatus::Unsolvable;
+    return SolveStatus::Solved;
+}
+
+// ------------------------------------------------------
+// IDA* iterativo sobre el motor make/unmake
+// ------------------------------------------------------
+vector<pair<int,int>> iterativeIDAStar(const Puzzle &puzzle, const PatternDatabase &db, const SearchOptions &options,
+                                       SearchStats* stats) {
+    SearchStats local;
+    if (stats == nullptr)
+        stats = &local;
+    *stats = SearchStats();
+    stats->status = checkBoard(puzzle);
+    if (stats->status != SolveStatus::Solved)
+        return vector<pair<int,int>>();
+    SearchBudget budget(options.limits);
+    IDAStarEngine engine(PackedState::fromPuzzle(puzzle), db, options);
+    engine.setBudget(&budget);
+    engine.setProgress(options.progress);
+    unique_ptr<TranspositionTable> table;
+    if (options.transpositionEntries > 0) {
+        table.reset(new TranspositionTable(options.transpositionEntries));
+        engine.setTranspositionTable(table.get());
+    }
+    stats->status = engine.solve();
+    stats->nodes = engine.generatedNodes();
+    stats->bound = engine.lastBound();
+    if (stats->status != SolveStatus::Solved)
+        return vector<pair<int,int>>(); // No se encontró solución o se detuvo
+    stats->suboptimality = engine.suboptimality();
+    return engine.path().toDirections();
+}
+
+// ------------------------------------------------------
+// IDA* paralelo: en cada iteración el árbol se corta a poca profundidad y
+// cada subárbol de la frontera (en el orden DFS del motor secuencial) es una
+// tarea del pool. Si un subárbol encuentra solución, los de índice mayor se
+// abandonan y los de índice menor terminan: gana la primera solución en
+// orden DFS, la misma que devolvería iterativeIDAStar.
+// ------------------------------------------------------
+struct FrontierNode {
+    PackedState state;
+    MovePath prefix;
+    int g;
+};
+
+// Recorre en orden DFS hasta depthLimit y recoge los nodos con f <= bound
+// (f escalado como en IDAStarEngine si hay peso)
+void collectFrontier(PackedState &state, MovePath &prefix, int g, int depthLimit, int bound,
+                     const PatternDatabase &db, const SearchOptions &options, const WeightedCost &cost,
+                     vector<FrontierNode> &frontier, int &newBound) {
+    int f = cost.f(g, hScore(state, db, options.reflect));
+    if (f > bound) {
+        newBound = min(newBound, f);
+        return;
+    }
+    if (g == depthLimit || state.isGoal()) {
+        frontier.push_back({state, prefix, g});
+        return;
+    }
+    for (int dir = 0; dir < 4; dir++){
+        if (prefix.length > 0 && dir == oppositeDirection(prefix.last()))
+            continue;
+        if (!state.canMove(dir))
+            continue;
+        state.applyMove(dir);
+        prefix.push(dir);
+        collectFrontier(state, prefix, g + 1, depthLimit, bound, db, options, cost, frontier, newBound);
+        prefix.pop();
+        state.applyMove(oppositeDirection(dir));
+    }
+}
+
+vector<pair<int,int>> parallelIDAStar(const Puzzle &puzzle, const PatternDatabase &db, WorkStealingPool &pool,
+                                      const SearchOptions &options, SearchStats* stats) {
+    SearchStats local;
+    if (stats == nullptr)
+        stats = &local;
+    *stats = SearchStats();
+    stats->status = checkBoard(puzzle);
+    PackedState start = PackedState::fromPuzzle(puzzle);
+    if (stats->status != SolveStatus::Solved || start.isGoal())
+        return vector<pair<int,int>>();
+    SearchBudget budget(options.limits);
+    atomic<uint64_t> nodes(0);
+    // Subárboles suficientes para repartir y equilibrar la carga
+    const size_t targetTasks = (size_t)pool.threadCount() * 16;
+    const int maxSplitDepth = 16;
+    const WeightedCost cost(options.weight);
+    int bound = cost.f(0, hScore(start, db, options.reflect));
+    while (true) {
+        stats->bound = cost.lowerBound(bound);
+        if (!budget.charge(0)) {
+            stats->status = budget.reason();
+            stats->nodes = nodes.load();
+            return vector<pair<int,int>>();
+        }
+        if (options.progress)
+            options.progress(stats->bound, nodes.load());
+        vector<FrontierNode> frontier;
+        int newBound = INF;
+        for (int depthLimit = 1; ; depthLimit++){
+            frontier.clear();
+            newBound = INF;
+            PackedState root = start;
+            MovePath prefix;
+            collectFrontier(root, prefix, 0, depthLimit, bound, db, options, cost, frontier, newBound);
+            if (frontier.size() >= targetTasks || depthLimit >= maxSplitDepth || frontier.empty())
+                break;
+        }
+
+        size_t count = frontier.size();
+        atomic<size_t> bestIndex(SIZE_MAX);
+        vector<int> results(count, INF);
+        vector<MovePath> paths(count);
+        TaskGroup group(count);
+        for (size_t i = 0; i < count; i++){
+            // Reparto round-robin: todos los hilos empiezan por los subárboles de menor índice
+            pool.submit((int)(i % (size_t)pool.threadCount()), [&, i] {
+                if (bestIndex.load(memory_order_relaxed) > i && !budget.stopped()) {
+                    const FrontierNode &node = frontier[i];
+                    int lastDir = node.prefix.length > 0 ? node.prefix.last() : -1;
+                    IDAStarEngine engine(node.state, db, options, node.g, lastDir);
+                    engine.setStopCheck([&bestIndex, i] { return bestIndex.load(memory_order_relaxed) < i; });
+                    engine.setBudget(&budget);
+                    int t = engine.iterate(bound);
+                    nodes.fetch_add(engine.generatedNodes(), memory_order_relaxed);
+                    results[i] = t;
+                    if (t == IDAStarEngine::FOUND) {
+                        paths[i] = engine.path();
+                        size_t current = bestIndex.load();
+                        while (i < current && !bestIndex.compare_exchange_weak(current, i)) {}
+                    }
+                }
+                group.done();
+            });
+        }
+        group.wait();
+        stats->nodes = nodes.load();
+
+        // Con cota admisible toda solución de esta iteración es óptima (con
+        // peso, dentro del factor), aunque un límite haya cortado subárboles
+        // de índice menor
+        size_t best = bestIndex.load();
+        if (best != SIZE_MAX) {
+            stats->status = SolveStatus::Solved;
+            MovePath solution = frontier[best].prefix;
+            for (int i = 0; i < paths[best].length; i++){
+                solution.push(paths[best].at(i));
+            }
+            stats->suboptimality = cost.suboptimality(solution.length, bound);
+            return solution.toDirections();
+        }
+        if (budget.stopped()) {
+            stats->status = budget.reason();
+            return vector<pair<int,int>>();
+        }
+        for (int t : results){
+            if (t >= 0)
+                newBound = min(newBound, t);
+        }
+        if (newBound == INF) {
+            stats->status = SolveStatus::NoSolution;
+            return vector<pair<int,int>>(); // No se encontró solución
+        }
+        bound = newBound;
+    }
+}
@@ -0,0 +1,490 @@
+// ida_star.h
+// Búsqueda IDA* sobre PackedState: motor make/unmake secuencial y versión
+// paralela sobre el pool de hilos.
+#pragma once
+
+#include "heuristic.h"
+#include "perimeter.h"
+#include "puzzle.h"
+#include "search_limits.h"
+#include "thread_pool.h"
+#include "transposition_table.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+const int INF = 100000;
+
+// Comprobación previa a la búsqueda sobre PackedState: Solved si el tablero
+// es 4x4, válido y con solución
+SolveStatus checkBoard(const Puzzle &puzzle);
+
+// Progreso de una resolución: se llama al empezar cada iteración de IDA*
+// con su límite de f y los nodos generados hasta entonces
+using SearchProgress = std::function<void(int bound, uint64_t nodes)>;
+
+// Opciones de búsqueda comunes a todos los modos
+struct SearchOptions {
+    bool reflect = false;   // PDB también sobre el tablero reflejado (máximo de ambos)
+    SearchLimits limits;    // cancelación, tiempo máximo y presupuesto de nodos
+    SearchProgress progress; // solo iterativeIDAStar y parallelIDAStar, en el hilo que llama
+    // Entradas de la tabla de transposiciones de cada resolución secuencial
+    // (0: sin tabla). IDA* paralelo no la usa.
+    size_t transpositionEntries = 0;
+    // Expandir los hijos por f creciente. En paralelo el camino puede diferir
+    // del secuencial, con la misma longitud.
+    bool orderMoves = false;
+    // Profundidad del perímetro del objetivo (0: sin perímetro, como mucho
+    // Perimeter::MAX_DEPTH). Se genera una vez por proceso.
+    int perimeterDepth = 0;
+    // Peso w de f = g + w·h (ver WeightedCost). 1: solución óptima; con
+    // w > 1 la solución mide como mucho w veces la óptima y no se usa la
+    // tabla de transposiciones.
+    double weight = 1.0;
+    // > 0: solo se buscan soluciones más cortas (p. ej. que una ya conocida):
+    // se podan los nodos con g + h >= costLimit y NoSolution prueba que no
+    // las hay. Tampoco usa la tabla de transposiciones. Los motores podan
+    // siempre con g + h >= MovePath::MAX_DEPTH (caminos no representables).
+    int costLimit = 0;
+};
+
+// Estadísticas de una búsqueda, también parciales si la detuvo un límite
+struct SearchStats {
+    SolveStatus status = SolveStatus::NoSolution;
+    uint64_t nodes = 0;     // nodos generados
+    int bound = 0;          // cota inferior de la longitud óptima (último límite de f sin peso)
+    // La solución mide como mucho suboptimality veces la óptima (1: óptima)
+    double suboptimality = 1.0;
+};
+
+// ------------------------------------------------------
+// IDA* con peso (f = g + w·h) en aritmética entera: f escalado = gScale·g +
+// hScale·h, con w redondeado a múltiplos de 1/WEIGHT_SCALE. Sin peso ambas
+// escalas son 1 y f es el de siempre.
+// Cota inferior del óptimo C*: en el camino óptimo todo nodo cumple
+// f <= gScale·g + hScale·h* <= hScale·C*, y el límite de cada iteración es
+// el menor f que quedó fuera en la anterior (que no encontró solución), así
+// que C* >= ceil(límite / hScale). Una solución encontrada con ese límite
+// mide como mucho límite / gScale, es decir w veces esa cota.
+// ------------------------------------------------------
+const int WEIGHT_SCALE = 16;
+const double MAX_SEARCH_WEIGHT = 8.0;   // f escalado se mantiene lejos de INF
+
+struct WeightedCost {
+    int gScale = 1;
+    int hScale = 1;
+
+    explicit WeightedCost(double weight = 1.0) {
+        int scaled = (int)(std::min(weight, MAX_SEARCH_WEIGHT) * WEIGHT_SCALE + 0.5);
+        if (scaled > WEIGHT_SCALE) {
+            gScale = WEIGHT_SCALE;
+            hScale = scaled;
+        }
+    }
+
+    bool weighted() const {
+        return hScale != gScale;
+    }
+
+    double weight() const {
+        return (double)hScale / gScale;
+    }
+
+    int f(int g, int h) const {
+        return gScale * g + hScale * h;
+    }
+
+    // Cota inferior de la longitud óptima dado el límite de f de la iteración en curso
+    int lowerBound(int bound) const {
+        return (bound + hScale - 1) / hScale;
+    }
+
+    // Factor probado de la solución de longitud length respecto al óptimo
+    double suboptimality(int length, int bound) const {
+        int lower = lowerBound(bound);
+        if (!weighted() || length <= lower)
+            return 1.0;
+        return std::min(weight(), (double)length / lower);
+    }
+};
+
+// ------------------------------------------------------
+// Motor IDA* sin reservas de memoria: aplica y deshace los movimientos
+// sobre un único estado (make/unmake). Cada marco de la pila guarda la
+// siguiente dirección a probar y cómo restaurar la heurística; h se
+// actualiza de forma incremental una vez al generar el hijo.
+// La raíz puede ser un nodo interior (costo rootG y último movimiento
+// rootLastDir), lo que permite buscar subárboles en paralelo.
+// Con tabla de transposiciones se podan los estados ya expandidos en la
+// iteración con g menor o igual y, al agotarse un subárbol, se guarda como
+// h aprendida el menor f que quedó fuera menos su g. Al volver al padre el
+// costo es 1 + h(padre), así que ese movimiento también entra en el mínimo
+// y la h aprendida sigue siendo admisible.
+// Con orderMoves, al entrar en un nodo se evalúan sus hijos una vez: los que
+// superan el límite se descartan allí y el resto se expande por f creciente
+// (a igual f, en el orden de Puzzle::DIRECTIONS). Así, en la última
+// iteración la solución aparece antes; las iteraciones que fallan recorren
+// el mismo árbol en otro orden.
+// Con perímetro, los estados con h <= su profundidad se buscan en él: dentro
+// h pasa a ser la distancia exacta y fuera al menos profundidad + 1. Un
+// estado del perímetro dentro del límite termina la búsqueda (su f es el
+// costo de una solución y no supera una cota inferior del óptimo) y el
+// camino se completa bajando por el perímetro.
+// Con options.weight > 1 los límites y los f son los escalados de
+// WeightedCost; lastBound() sigue siendo la cota inferior sin peso.
+// ------------------------------------------------------
+class IDAStarEngine {
+public:
+    static const int FOUND = -1;
+    static const int ABORTED = -2;
+    // Cada cuántos nodos generados se consultan el presupuesto y stopRequested
+    static const uint64_t STOP_CHECK_INTERVAL = 4096;
+
+    IDAStarEngine(const PackedState &start, const PatternDatabase &db, const SearchOptions &options = SearchOptions(),
+                  int rootG = 0, int rootLastDir = -1)
+            : state(start), heuristic(db, options.reflect), rootG(rootG), rootLastDir(rootLastDir),
+              orderMoves(options.orderMoves), cost(options.weight),
+              costLimit(options.costLimit > 0 ? std::min(options.costLimit, MovePath::MAX_DEPTH) : MovePath::MAX_DEPTH),
+              perimeter(Perimeter::forDepth(options.perimeterDepth)) {
+        heuristic.reset(state);
+        // Paridad de la distancia al objetivo: la del Manhattan total
+        rootParity = manhattan(state, ~0u) & 1;
+    }
+
+    // Ejecuta IDA* completo. Solved si encontró solución (ver path()); si lo
+    // detuvo un límite, el motivo del presupuesto.
+    SolveStatus solve() {
+        solveBound = cost.f(rootG, heuristic.value());
+        while (true) {
+            if (budget != nullptr && !budget->charge(0))
+                return budget->reason();
+            if (progress)
+                progress(cost.lowerBound(solveBound), nodes);
+            int t = iterate(solveBound);
+            if (t == FOUND)
+                return SolveStatus::Solved;
+            if (t == ABORTED)
+                return budget != nullptr && budget->stopped() ? budget->reason() : SolveStatus::Cancelled;
+            // Sin f por encima del límite (solo hijos cortados por profundidad)
+            // no hay límite mayor que probar
+            if (t == INF || t <= solveBound)
+                return SolveStatus::NoSolution;
+            solveBound = t;
+        }
+    }
+
+    // Una iteración acotada por bound (sobre f = rootG + g + h, escalado con
+    // peso): retorna FOUND, ABORTED o el menor f que superó el límite (INF si
+    // no hubo ninguno). Los hijos con g + h >= costLimit no llevan a una
+    // solución que quepa (en MovePath o bajo options.costLimit): se podan
+    // sin contar para el siguiente límite, que así siempre crece.
+    int iterate(int bound) {
+        movePath.length = 0;
+        if (table != nullptr)
+            table->beginIteration();
+        int h = childValue(rootG);
+        if (rootG + h >= costLimit)
+            return INF;
+        if (cost.f(rootG, h) > bound)
+            return cost.f(rootG, h);
+        if (state.isGoal() || (inPerimeter(h) && completePath()))
+            return FOUND;
+
+        int newBound = INF;
+        int depth = 0;
+        frameH[0] = h;
+        if (!enterFrame(0, bound, newBound))
+            return ABORTED;
+        while (depth >= 0) {
+            if (nextDir[depth] == childCount[depth]) {
+                // Todos los hijos explorados: deshacer el movimiento que llevó aquí
+                if (depth == 0)
+                    break;
+                int childMin = subtreeMin[depth];
+                if (table != nullptr && childMin - (rootG + depth) > frameH[depth])
+                    table->learn(state.tiles, state.hashKey(), childMin - (rootG + depth));
+                unmakeMove(movePath.last(), undo[depth]);
+                movePath.pop();
+                depth--;
+                subtreeMin[depth] = std::min(subtreeMin[depth], childMin);
+                continue;
+            }
+            int dir = (childOrder[depth] >> (nextDir[depth]++ << 1)) & 3;
+            if (!orderMoves) {
+                // Evitar revertir el último movimiento
+                int last = depth > 0 ? movePath.last() : rootLastDir;
+                if (last >= 0 && dir == oppositeDirection(last)) {
+                    if (depth > 0)
+                        subtreeMin[depth] = std::min(subtreeMin[depth], cost.f(rootG + depth + 1, frameH[depth - 1]));
+                    continue;
+                }
+                if (!state.canMove(dir))
+                    continue;
+            }
+
+            makeMove(dir, undo[depth + 1]);
+            // Con orden los hijos ya se contaron (y se comprobó la parada) al ordenarlos
+            if (!orderMoves && (++nodes & (STOP_CHECK_INTERVAL - 1)) == 0 && shouldStop()) {
+                unmakeMove(dir, undo[depth + 1]);
+                unwind(depth);
+                return ABORTED;
+            }
+            int g = rootG + depth + 1;
+            int childH = heuristic.value();
+            const TranspositionTable::Entry* entry = nullptr;
+            uint64_t hash = 0;
+            if (table != nullptr) {
+                hash = state.hashKey();
+                entry = table->find(state.tiles, hash);
+                if (entry != nullptr)
+                    childH = std::max(childH, (int)entry->h);
+            }
+            childH = perimeterValue(childH, g);
+            if (g + childH >= costLimit) {
+                // f sigue siendo cota válida para la h aprendida de la tabla
+                subtreeMin[depth] = std::min(subtreeMin[depth], cost.f(g, childH));
+                unmakeMove(dir, undo[depth + 1]);
+                continue;
+            }
+            int f = cost.f(g, childH);
+            if (f > bound) {
+                newBound = std::min(newBound, f);
+                subtreeMin[depth] = std::min(subtreeMin[depth], f);
+                unmakeMove(dir, undo[depth + 1]);
+                continue;
+            }
+            if (table != nullptr) {
+                if (table->isDuplicate(entry, g)) {
+                    subtreeMin[depth] = std::min(subtreeMin[depth], f);
+                    unmakeMove(dir, undo[depth + 1]);
+                    continue;
+                }
+                table->recordVisit(state.tiles, hash, g);
+            }
+            movePath.push(dir);
+            if (state.isGoal() || (inPerimeter(childH) && completePath()))
+                return FOUND;
+            depth++;
+            frameH[depth] = childH;
+            if (!enterFrame(depth, bound, newBound)) {
+                unwind(depth);
+                return ABORTED;
+            }
+        }
+        return newBound;
+    }
+
+    const MovePath& path() const {
+        return movePath;
+    }
+
+    uint64_t generatedNodes() const {
+        return nodes;
+    }
+
+    // Cota inferior de la longitud óptima según el límite de la última
+    // iteración de solve() (el propio límite sin peso)
+    int lastBound() const {
+        return cost.lowerBound(solveBound);
+    }
+
+    // Factor probado de path() respecto al óptimo tras resolver (1 sin peso)
+    double suboptimality() const {
+        return cost.suboptimality(movePath.length, solveBound);
+    }
+
+    // Condición de parada cooperativa (p. ej. otro hilo ya encontró solución)
+    void setStopCheck(std::function<bool()> check) {
+        stopRequested = std::move(check);
+    }
+
+    // Se llama al empezar cada iteración de solve()
+    void setProgress(SearchProgress callback) {
+        progress = std::move(callback);
+    }
+
+    // Tabla de transposiciones (nullptr: sin tabla); no puede compartirse
+    // entre motores que buscan a la vez. Con peso o costLimit se ignora: la
+    // h aprendida sale de f escalados o de subárboles podados y no sería
+    // admisible.
+    void setTranspositionTable(TranspositionTable* transpositions) {
+        table = cost.weighted() || costLimit < MovePath::MAX_DEPTH ? nullptr : transpositions;
+    }
+
+    // Límites de la resolución; puede compartirse entre varios motores
+    void setBudget(SearchBudget* searchBudget) {
+        budget = searchBudget;
+    }
+
+
+private:
+    PackedState state;
+    IncrementalHeuristic heuristic;
+    int rootG;
+    int rootLastDir;
+    bool orderMoves;
+    WeightedCost cost;
+    int costLimit;                  // options.costLimit, como mucho MovePath::MAX_DEPTH
+    uint64_t nodes = 0;
+    int solveBound = 0;
+    SearchBudget* budget = nullptr;
+    std::function<bool()> stopRequested;
+    SearchProgress progress;
+    TranspositionTable* table = nullptr;
+    std::shared_ptr<const Perimeter> perimeter; // de options.perimeterDepth, o nullptr
+    int rootParity = 0;
+    MovePath movePath;
+    // Por nivel: hijos a expandir (2 bits cada uno, en orden), cuántos y el siguiente
+    uint8_t childOrder[MovePath::MAX_DEPTH + 1];
+    uint8_t childCount[MovePath::MAX_DEPTH + 1];
+    uint8_t nextDir[MovePath::MAX_DEPTH + 1];
+    HeuristicUndo undo[MovePath::MAX_DEPTH + 1];
+    // h usada en cada nivel y menor f fuera del límite en su subárbol (para la tabla)
+    int frameH[MovePath::MAX_DEPTH + 1];
+    int subtreeMin[MovePath::MAX_DEPTH + 1];
+
+    void makeMove(int dir, HeuristicUndo &u) {
+        int from = state.blank + PackedState::OFFSETS[dir];
+        int to = state.blank;
+        int tile = state.tileAt(from);
+        state.applyMove(dir);
+        heuristic.moveTile(tile, from, to, u);
+    }
+
+    void unmakeMove(int dir, const HeuristicUndo &u) {
+        int from = state.blank; // la ficha vuelve a la celda donde está el hueco
+        int tile = state.tileAt(from - PackedState::OFFSETS[dir]);
+        state.applyMove(oppositeDirection(dir));
+        heuristic.undoMove(tile, from, u);
+    }
+
+    // h del estado actual (a costo g), con la h aprendida si hay tabla y el perímetro
+    int childValue(int g) const {
+        int h = heuristic.value();
+        if (table != nullptr) {
+            const TranspositionTable::Entry* entry = table->find(state.tiles, state.hashKey());
+            if (entry != nullptr)
+                h = std::max(h, (int)entry->h);
+        }
+        return perimeterValue(h, g);
+    }
+
+    // Con perímetro, h admisible del estado actual (a costo g) corregida:
+    // exacta dentro del perímetro y fuera la menor distancia mayor que su
+    // profundidad con la paridad del estado (la de la raíz más g; cada
+    // movimiento la cambia). Sin la paridad los límites de f avanzarían de 1
+    // en 1 con iteraciones que no pueden encontrar nada.
+    int perimeterValue(int h, int g) const {
+        if (perimeter == nullptr || h > perimeter->depth())
+            return h;
+        int d = perimeter->distance(state.tiles);
+        if (d >= 0)
+            return d;
+        int outside = perimeter->depth() + 1;
+        return outside + ((outside + g - rootG + rootParity) & 1);
+    }
+
+    // h ya corregida por perimeterValue: el estado actual está en el perímetro
+    bool inPerimeter(int h) const {
+        return perimeter != nullptr && h <= perimeter->depth();
+    }
+
+    // Camino del estado actual (del perímetro) al objetivo. La poda por
+    // g + h >= costLimit ya deja sitio en movePath; false si no cabe.
+    bool completePath() {
+        return perimeter == nullptr || perimeter->appendPathToGoal(state, movePath);
+    }
+
+    // Prepara el nivel depth (estado actual, ya en el camino). Sin orden se
+    // prueban las 4 direcciones; con orden, ver orderChildren.
+    bool enterFrame(int depth, int bound, int &newBound) {
+        nextDir[depth] = 0;
+        subtreeMin[depth] = INF;
+        if (!orderMoves) {
+            childOrder[depth] = 0xE4; // 0, 1, 2, 3
+            childCount[depth] = 4;
+            return true;
+        }
+        return orderChildren(depth, bound, newBound);
+    }
+
+    // Evalúa cada hijo, descarta los que superan el límite y ordena el resto
+    // por f creciente (orden estable). false si hay que parar.
+    bool orderChildren(int depth, int bound, int &newBound) {
+        int count = 0;
+        int dirs[4], fs[4];
+        int last = depth > 0 ? movePath.last() : rootLastDir;
+        for (int dir = 0; dir < 4; dir++){
+            if (last >= 0 && dir == oppositeDirection(last)) {
+                if (depth > 0)
+                    subtreeMin[depth] = std::min(subtreeMin[depth], cost.f(rootG + depth + 1, frameH[depth - 1]));
+                continue;
+            }
+            if (!state.canMove(dir))
+                continue;
+            makeMove(dir, undo[depth + 1]);
+            if ((++nodes & (STOP_CHECK_INTERVAL - 1)) == 0 && shouldStop()) {
+                unmakeMove(dir, undo[depth + 1]);
+                return false;
+            }
+            int g = rootG + depth + 1;
+            int h = childValue(g);
+            unmakeMove(dir, undo[depth + 1]);
+            if (g + h >= costLimit) {
+                subtreeMin[depth] = std::min(subtreeMin[depth], cost.f(g, h));
+                continue;
+            }
+            int f = cost.f(g, h);
+            if (f > bound) {
+                newBound = std::min(newBound, f);
+                subtreeMin[depth] = std::min(subtreeMin[depth], f);
+                continue;
+            }
+            // Inserción ordenada (como mucho 3 hijos)
+            int i = count++;
+            for (; i > 0 && fs[i - 1] > f; i--){
+                dirs[i] = dirs[i - 1];
+                fs[i] = fs[i - 1];
+            }
+            dirs[i] = dir;
+            fs[i] = f;
+        }
+        uint8_t order = 0;
+        for (int i = 0; i < count; i++){
+            order |= (uint8_t)(dirs[i] << (i << 1));
+        }
+        childOrder[depth] = order;
+        childCount[depth] = (uint8_t)count;
+        return true;
+    }
+
+    bool shouldStop() {
+        if (budget != nullptr && !budget->charge(STOP_CHECK_INTERVAL))
+            return true;
+        return stopRequested && stopRequested();
+    }
+
+    // Deshace el camino hasta la raíz (tras abortar una iteración)
+    void unwind(int depth) {
+        for (; depth > 0; depth--){
+            unmakeMove(movePath.last(), undo[depth]);
+            movePath.pop();
+        }
+    }
+};
+
+// IDA* iterativo sobre el motor make/unmake. Vacío si no hay solución o si
+// lo detuvo un límite (ver stats); los tableros que no pasan checkBoard se
+// rechazan sin buscar.
+std::vector<std::pair<int,int>> iterativeIDAStar(const Puzzle &puzzle, const PatternDatabase &db,
+                                                 const SearchOptions &options = SearchOptions(),
+                                                 SearchStats* stats = nullptr);
+
+// IDA* paralelo sobre pool; devuelve la misma solución que iterativeIDAStar.
+// Los límites de options cubren la resolución completa, no cada tarea.
+std::vector<std::pair<int,int>> parallelIDAStar(const Puzzle &puzzle, const PatternDatabase &db, WorkStealingPool &pool,
+                                                const SearchOptions &options = SearchOptions(),
+                                                SearchStats* stats = nullptr);
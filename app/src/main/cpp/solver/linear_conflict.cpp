@@ -0,0 +1,55 @@
+// linear_conflict.cpp
+
+#include "linear_conflict.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+using namespace std;
+
+LinearConflictTable::LinearConflictTable(int side) : side(side) {
+    uint32_t count = 1;
+    for (int i = 0; i < side; i++){
+        powers.push_back(count);
+        count *= (uint32_t)(side + 1);
+    }
+    emptyCode = 0;
+    for (int i = 0; i < side; i++){
+        emptyCode += (uint32_t)side * powers[i];
+    }
+    conflicts.assign(count, 0);
+    int digits[8];
+    for (uint32_t code = 0; code < count; code++){
+        int present = 0;
+        uint32_t rest = code;
+        for (int i = 0; i < side; i++, rest /= (uint32_t)(side + 1)){
+            int digit = (int)(rest % (uint32_t)(side + 1));
+            if (digit != side)
+                digits[present++] = digit;
+        }
+        // Subsecuencia creciente más larga de las posiciones objetivo
+        int longest[8];
+        int best = 0;
+        for (int i = 0; i < present; i++){
+            longest[i] = 1;
+            for (int j = 0; j < i; j++){
+                if (digits[j] < digits[i] && longest[j] + 1 > longest[i])
+                    longest[i] = longest[j] + 1;
+            }
+            if (longest[i] > best)
+                best = longest[i];
+        }
+        conflicts[code] = (uint8_t)(2 * (present - best));
+    }
+}
+
+const LinearConflictTable& LinearConflictTable::forSide(int side) {
+    static mutex tablesMutex;
+    static map<int, unique_ptr<LinearConflictTable>> tables;
+    lock_guard<mutex> lock(tablesMutex);
+    unique_ptr<LinearConflictTable> &table = tables[side];
+    if (!table)
+        table.reset(new LinearConflictTable(side));
+    return *table;
+}
@@ -0,0 +1,34 @@
+// linear_conflict.h
+// Tablas de conflictos lineales por línea (fila o columna).
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// ------------------------------------------------------
+// El código de una línea de side celdas es un número en base side + 1: el
+// dígito de la posición i es la posición objetivo, dentro de la línea, de la
+// ficha que ocupa la celda i si su objetivo está en esta misma línea, o side
+// si la celda no cuenta. conflicts[código] son los movimientos extra que
+// cuestan esas fichas: 2 por cada ficha que debe salir de la línea para que
+// el resto quede en orden (side - subsecuencia creciente más larga).
+// ------------------------------------------------------
+class LinearConflictTable {
+public:
+    int side;
+    uint32_t emptyCode;               // todas las posiciones con dígito side
+    std::vector<uint32_t> powers;     // (side + 1)^i
+    std::vector<uint8_t> conflicts;
+
+    // Tabla compartida del proceso para el tamaño de línea side
+    static const LinearConflictTable& forSide(int side);
+
+    // Variación del código al poner (sign = 1) o quitar (sign = -1) una ficha
+    // con posición objetivo goalPos en la posición pos
+    int32_t codeDelta(int pos, int goalPos, int sign) const {
+        return sign * (goalPos - side) * (int32_t)powers[pos];
+    }
+
+private:
+    explicit LinearConflictTable(int side);
+};
@@ -0,0 +1,615 @@
+// pattern_db.cpp
+
+#include "pattern_db.h"
+#include "puzzle.h"
+#include "walking_distance.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <nlohmann/json.hpp>  // Usando nlohmann::json
+
+using json = nlohmann::json;
+using namespace std;
+
+// ------------------------------------------------------
+// Ranking de k-permutaciones (ver pattern_db.h)
+// ------------------------------------------------------
+uint64_t permutationCount(int n, int k) {
+    uint64_t count = 1;
+    for (int i = 0; i < k; i++){
+        count *= (uint64_t)(n - i);
+    }
+    return count;
+}
+
+void unrankPattern(uint64_t rank, int k, int n, int* positions) {
+    int digits[32];
+    for (int i = k - 1; i >= 0; i--){
+        digits[i] = (int)(rank % (uint64_t)(n - i));
+        rank /= (uint64_t)(n - i);
+    }
+    uint32_t used = 0;
+    for (int i = 0; i < k; i++){
+        // La celda es la digits[i]-ésima libre
+        int cell = 0;
+        for (int free = digits[i]; ; cell++){
+            if (used & (1u << cell))
+                continue;
+            if (free-- == 0)
+                break;
+        }
+        positions[i] = cell;
+        used |= 1u << cell;
+    }
+}
+
+void PatternDatabase::addOwnedGroup(const vector<int>& tiles, vector<uint8_t> table, int entryBits,
+                                    uint32_t compression) {
+    PatternGroup group;
+    group.tiles = tiles;
+    group.mask = 0;
+    for (int tile : tiles) {
+        group.mask |= 1u << tile;
+    }
+    ownedTables.push_back(std::move(table));
+    group.table = ownedTables.back().data();
+    group.entries = permutationCount(boardSize * boardSize, (int)tiles.size());
+    group.entryBits = entryBits;
+    group.compression = compression;
+    group.complete = true;
+    if (entryBits == PDB_ENCODING_BYTE) {
+        group.complete = find(ownedTables.back().begin(), ownedTables.back().end(), PDB_MISSING) == ownedTables.back().end();
+    } else if (entryBits == PDB_ENCODING_NIBBLE) {
+        for (uint64_t rank = 0; rank < group.entries && group.complete; rank++){
+            group.complete = patternCode(group, rank) != PDB_NIBBLE_MISSING;
+        }
+    }
+    groups.push_back(group);
+}
+
+// ------------------------------------------------------
+// Colocaciones de un grupo: vecinas, Manhattan y tablas mod 3
+// ------------------------------------------------------
+// Llama a visit(rank) por cada colocación vecina (una ficha del grupo pasa a
+// una celda contigua sin fichas del grupo) con positions ya modificado. Si
+// visit retorna true el movimiento se conserva y el recorrido termina.
+template <typename Visit>
+bool forEachPatternMove(int* positions, int k, int boardSize, Visit visit) {
+    int cells = boardSize * boardSize;
+    uint32_t occupied = 0;
+    for (int i = 0; i < k; i++){
+        occupied |= 1u << positions[i];
+    }
+    const int deltas[4] = { boardSize, -boardSize, 1, -1 };
+    for (int i = 0; i < k; i++){
+        int from = positions[i], col = from % boardSize;
+        for (int d = 0; d < 4; d++){
+            if ((d == 0 && from + boardSize >= cells) || (d == 1 && from < boardSize)
+                || (d == 2 && col == boardSize - 1) || (d == 3 && col == 0))
+                continue;
+            int to = from + deltas[d];
+            if (occupied & (1u << to))
+                continue;
+            positions[i] = to;
+            if (visit(rankPattern(positions, k, cells)))
+                return true;
+            positions[i] = from;
+        }
+    }
+    return false;
+}
+
+int placementManhattan(const vector<int>& tiles, const int* positions, int boardSize) {
+    int h = 0;
+    for (size_t i = 0; i < tiles.size(); i++){
+        int goal = tiles[i] - 1;
+        h += abs(goal / boardSize - positions[i] / boardSize) + abs(goal % boardSize - positions[i] % boardSize);
+    }
+    return h;
+}
+
+int mod3Distance(const PatternGroup &group, const int* positions, int boardSize) {
+    int k = (int)group.tiles.size();
+    int current[PDB_MAX_GROUP_TILES];
+    copy(positions, positions + k, current);
+    int steps = 0;
+    while (placementManhattan(group.tiles, current, boardSize) > 0) {
+        int code = patternCode(group, rankPattern(current, k, boardSize * boardSize));
+        uint8_t lower = (uint8_t)((code + 2) % 3);
+        if (!forEachPatternMove(current, k, boardSize, [&](uint64_t rank) { return patternCode(group, rank) == lower; }))
+            return 0; // la tabla no es de distancias exactas (encodePatternDB lo impide)
+        steps++;
+    }
+    return steps;
+}
+
+// Archivo en disco mapeado con mmap (Linux y Android)
+class MappedFileBlob : public PdbBlob {
+public:
+    MappedFileBlob(void* addr, size_t length) : addr(addr), length(length) {}
+    ~MappedFileBlob() override { munmap(addr, length); }
+    const uint8_t* data() const override { return (const uint8_t*)addr; }
+    size_t size() const override { return length; }
+private:
+    void* addr;
+    size_t length;
+};
+
+unique_ptr<PdbBlob> mapPdbFile(const string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return nullptr;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return nullptr;
+    }
+    void* addr = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED)
+        return nullptr;
+    return unique_ptr<PdbBlob>(new MappedFileBlob(addr, (size_t)st.st_size));
+}
+
+// Opener de nombres relativos instalado por la plataforma (ver pattern_db.h)
+mutex g_assetOpenerMutex;
+AssetOpener g_assetOpener;
+
+void setAssetOpener(AssetOpener opener) {
+    lock_guard<mutex> lock(g_assetOpenerMutex);
+    g_assetOpener = std::move(opener);
+}
+
+unique_ptr<PdbBlob> openPdbSource(const string& name) {
+    if (name.empty())
+        return nullptr;
+    if (name[0] != '/') {
+        AssetOpener opener;
+        {
+            lock_guard<mutex> lock(g_assetOpenerMutex);
+            opener = g_assetOpener;
+        }
+        if (opener)
+            return opener(name);
+    }
+    return mapPdbFile(name);
+}
+
+// Lee un archivo completo: ruta en disco o nombre de asset
+bool readWholeFile(const string& filename, string& out) {
+    unique_ptr<PdbBlob> blob = openPdbSource(filename);
+    if (!blob || blob->size() == 0)
+        return false;
+    out.assign((const char*)blob->data(), blob->size());
+    return true;
+}
+
+// Las claves del JSON concatenan "fila columna" de las celdas que ocupa el grupo
+// (ver Puzzle::hash); se convierten a máscara de celdas ocupadas.
+bool parseOccupancyKey(const string& key, int boardSize, uint32_t& cells) {
+    if (key.size() % 2 != 0)
+        return false;
+    cells = 0;
+    for (size_t i = 0; i < key.size(); i += 2){
+        int row = key[i] - '0', col = key[i + 1] - '0';
+        if (row < 0 || row >= boardSize || col < 0 || col >= boardSize)
+            return false;
+        cells |= 1u << (row * boardSize + col);
+    }
+    return true;
+}
+
+// Expande un diccionario de ocupación a la tabla plana por rango: todas las
+// permutaciones que ocupan las mismas celdas reciben el valor de esa clave.
+vector<uint8_t> buildPatternTable(const vector<int>& tiles, const json& dict, int boardSize) {
+    int cells = boardSize * boardSize;
+    vector<uint8_t> byOccupancy((size_t)1 << cells, PDB_MISSING);
+    for (auto it = dict.begin(); it != dict.end(); ++it) {
+        uint32_t occupied;
+        if (!parseOccupancyKey(it.key(), boardSize, occupied))
+            continue;
+        int value = it.value().get<int>();
+        byOccupancy[occupied] = (uint8_t)max(0, min(value, (int)PDB_MISSING - 1));
+    }
+    int k = (int)tiles.size();
+    vector<uint8_t> table(permutationCount(cells, k));
+    int positions[32];
+    for (uint64_t rank = 0; rank < table.size(); rank++){
+        unrankPattern(rank, k, cells, positions);
+        uint32_t occupied = 0;
+        for (int i = 0; i < k; i++){
+            occupied |= 1u << positions[i];
+        }
+        table[rank] = byOccupancy[occupied];
+    }
+    return table;
+}
+
+// Formato JSON original: "groups" (arrays de fichas) y "patternDbDict"
+// (un objeto clave de ocupación -> valor por grupo)
+shared_ptr<PatternDatabase> parsePatternDBJson(const string& jsonStr, int boardSize) {
+    if (boardSize != PackedState::SIDE)
+        return nullptr;
+    auto db = make_shared<PatternDatabase>();
+    db->boardSize = boardSize;
+    try {
+        json j = json::parse(jsonStr);
+        const json& groups = j["groups"];
+        const json& dicts = j["patternDbDict"];
+        if (groups.size() != dicts.size())
+            return nullptr;
+        for (size_t i = 0; i < groups.size(); i++) {
+            vector<int> tiles;
+            for (auto& num : groups[i]) {
+                int tile = num.get<int>();
+                if (tile < 0 || tile >= PackedState::CELLS)
+                    return nullptr;
+                tiles.push_back(tile);
+            }
+            sort(tiles.begin(), tiles.end());
+            db->addOwnedGroup(tiles, buildPatternTable(tiles, dicts[i], boardSize));
+        }
+    } catch (...) {
+        return nullptr;
+    }
+    return db;
+}
+
+// ------------------------------------------------------
+// Formato binario de PatternDB (versión 1, little-endian)
+//   PdbFileHeader | PdbGroupHeader x groupCount | tablas alineadas a 64 bytes
+// Las tablas se usan tal cual desde la memoria mapeada (sin copias), así que
+// cargar el archivo es O(1) y las páginas se comparten entre procesos.
+// Cada tabla ocupa patternTableBytes(entradas, entryBits, compression).
+// ------------------------------------------------------
+const char PDB_MAGIC[4] = { 'P', 'D', 'B', 'N' };
+const uint16_t PDB_FORMAT_VERSION = 1;
+const uint8_t PDB_RANK_KPERMUTATION = 0; // rankPattern sobre las celdas del tablero
+const size_t PDB_TABLE_ALIGNMENT = 64;
+const uint8_t PDB_FLAG_COMPLETE = 1;     // ninguna tabla tiene entradas PDB_MISSING
+
+struct PdbFileHeader {
+    char magic[4];
+    uint16_t version;
+    uint8_t rows;
+    uint8_t cols;
+    uint8_t groupCount;
+    uint8_t rankingScheme;
+    uint8_t entryBits;      // bits por entrada (PDB_ENCODING_*), igual en todas las tablas
+    uint8_t flags;          // PDB_FLAG_*
+    uint32_t checksum;      // FNV-1a de las tablas, en orden de grupo
+    uint32_t compression;   // rangos por entrada guardada, igual en todas (0 equivale a 1)
+    uint64_t fileSize;
+};
+
+struct PdbGroupHeader {
+    uint8_t tileCount;
+    uint8_t tiles[PDB_MAX_GROUP_TILES];
+    uint64_t entryCount;
+    uint64_t tableOffset;   // desde el inicio del archivo
+    uint64_t tableBytes;
+};
+
+static_assert(sizeof(PdbFileHeader) == 32, "PdbFileHeader debe ocupar 32 bytes");
+static_assert(sizeof(PdbGroupHeader) == 48, "PdbGroupHeader debe ocupar 48 bytes");
+
+uint32_t fnv1a(const uint8_t* data, size_t size, uint32_t hash) {
+    for (size_t i = 0; i < size; i++){
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool writePatternDBBinary(const PatternDatabase& db, const string& path) {
+    PdbFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, PDB_MAGIC, sizeof(PDB_MAGIC));
+    header.version = PDB_FORMAT_VERSION;
+    header.rows = (uint8_t)db.boardSize;
+    header.cols = (uint8_t)db.boardSize;
+    header.groupCount = (uint8_t)db.groups.size();
+    header.rankingScheme = PDB_RANK_KPERMUTATION;
+    header.entryBits = (uint8_t)(db.groups.empty() ? PDB_ENCODING_BYTE : db.groups[0].entryBits);
+    header.flags = PDB_FLAG_COMPLETE;
+    header.compression = db.groups.empty() ? 1 : db.groups[0].compression;
+
+    vector<PdbGroupHeader> groupHeaders(db.groups.size());
+    uint64_t offset = sizeof(PdbFileHeader) + groupHeaders.size() * sizeof(PdbGroupHeader);
+    uint32_t checksum = 2166136261u;
+    for (size_t g = 0; g < db.groups.size(); g++){
+        const auto& group = db.groups[g];
+        if (group.tiles.size() > (size_t)PDB_MAX_GROUP_TILES || group.table == nullptr
+            || group.entryBits != header.entryBits || group.compression != header.compression)
+            return false;
+        if (!group.complete)
+            header.flags &= (uint8_t)~PDB_FLAG_COMPLETE;
+        PdbGroupHeader& gh = groupHeaders[g];
+        memset(&gh, 0, sizeof(gh));
+        gh.tileCount = (uint8_t)group.tiles.size();
+        for (size_t i = 0; i < group.tiles.size(); i++){
+            gh.tiles[i] = (uint8_t)group.tiles[i];
+        }
+        offset = (offset + PDB_TABLE_ALIGNMENT - 1) / PDB_TABLE_ALIGNMENT * PDB_TABLE_ALIGNMENT;
+        gh.entryCount = group.entries;
+        gh.tableOffset = offset;
+        gh.tableBytes = patternTableBytes(group.entries, group.entryBits, group.compression);
+        offset += gh.tableBytes;
+        checksum = fnv1a(group.table, (size_t)gh.tableBytes, checksum);
+    }
+    header.checksum = checksum;
+    header.fileSize = offset;
+
+    ofstream out(path, ios::binary | ios::trunc);
+    if (!out.is_open())
+        return false;
+    out.write((const char*)&header, sizeof(header));
+    out.write((const char*)groupHeaders.data(), groupHeaders.size() * sizeof(PdbGroupHeader));
+    uint64_t written = sizeof(header) + groupHeaders.size() * sizeof(PdbGroupHeader);
+    const char zeros[PDB_TABLE_ALIGNMENT] = {};
+    for (size_t g = 0; g < db.groups.size(); g++){
+        out.write(zeros, (streamsize)(groupHeaders[g].tableOffset - written));
+        out.write((const char*)db.groups[g].table, (streamsize)groupHeaders[g].tableBytes);
+        written = groupHeaders[g].tableOffset + groupHeaders[g].tableBytes;
+    }
+    return out.good();
+}
+
+// Valida cabeceras y enlaza las tablas a la memoria del blob. Verificar el
+// checksum recorre todas las tablas, por eso es opcional.
+shared_ptr<PatternDatabase> parsePatternDBBinary(unique_ptr<PdbBlob> blob, int boardSize, bool verifyChecksum) {
+    if (!blob || blob->size() < sizeof(PdbFileHeader))
+        return nullptr;
+    const uint8_t* base = blob->data();
+    PdbFileHeader header;
+    memcpy(&header, base, sizeof(header));
+    uint32_t compression = max(header.compression, 1u);
+    if (memcmp(header.magic, PDB_MAGIC, sizeof(PDB_MAGIC)) != 0
+        || header.version != PDB_FORMAT_VERSION
+        || header.rankingScheme != PDB_RANK_KPERMUTATION
+        || (header.entryBits != PDB_ENCODING_BYTE && header.entryBits != PDB_ENCODING_NIBBLE
+            && header.entryBits != PDB_ENCODING_MOD3)
+        || (header.entryBits == PDB_ENCODING_MOD3 && !(header.flags & PDB_FLAG_COMPLETE))
+        || (compression > 1 && header.entryBits != PDB_ENCODING_BYTE)
+        || header.rows != boardSize || header.cols != boardSize
+        || boardSize < MIN_BOARD_SIDE || boardSize > PDB_MAX_BOARD_SIDE
+        || header.fileSize != blob->size())
+        return nullptr;
+    size_t headersEnd = sizeof(PdbFileHeader) + (size_t)header.groupCount * sizeof(PdbGroupHeader);
+    if (headersEnd > blob->size())
+        return nullptr;
+
+    int cells = boardSize * boardSize;
+    auto db = make_shared<PatternDatabase>();
+    db->boardSize = boardSize;
+    uint32_t checksum = 2166136261u;
+    for (int g = 0; g < header.groupCount; g++){
+        PdbGroupHeader gh;
+        memcpy(&gh, base + sizeof(PdbFileHeader) + g * sizeof(PdbGroupHeader), sizeof(gh));
+        if (gh.tileCount == 0 || gh.tileCount > PDB_MAX_GROUP_TILES
+            || gh.entryCount != permutationCount(cells, gh.tileCount)
+            || gh.tableBytes != patternTableBytes(gh.entryCount, header.entryBits, compression)
+            || gh.tableOffset < headersEnd
+            || gh.tableOffset + gh.tableBytes > blob->size())
+            return nullptr;
+        PatternGroup group;
+        group.mask = 0;
+        for (int i = 0; i < gh.tileCount; i++){
+            if (gh.tiles[i] >= cells)
+                return nullptr;
+            group.tiles.push_back(gh.tiles[i]);
+            group.mask |= 1u << gh.tiles[i];
+        }
+        group.table = base + gh.tableOffset;
+        group.entries = gh.entryCount;
+        group.entryBits = header.entryBits;
+        group.compression = compression;
+        group.complete = (header.flags & PDB_FLAG_COMPLETE) != 0;
+        if (verifyChecksum)
+            checksum = fnv1a(group.table, (size_t)gh.tableBytes, checksum);
+        db->groups.push_back(group);
+    }
+    if (verifyChecksum && checksum != header.checksum)
+        return nullptr;
+    db->blob = std::move(blob);
+    return db;
+}
+
+bool endsWith(const string& value, const string& suffix) {
+    return value.size() >= suffix.size()
+           && value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+shared_ptr<PatternDatabase> builtinPatternDB(int boardSize, bool walkingDistance) {
+    if (boardSize != PackedState::SIDE)
+        return nullptr;
+    auto db = make_shared<PatternDatabase>();
+    db->boardSize = boardSize;
+    db->walkingDistance = walkingDistance && WalkingDistanceTable::forSide(boardSize) != nullptr;
+    PatternGroup group;
+    group.mask = 0;
+    for (int tile = 1; tile < boardSize * boardSize; tile++){
+        group.tiles.push_back(tile);
+        group.mask |= 1u << tile;
+    }
+    group.table = nullptr;
+    group.entries = 0;
+    db->groups.push_back(group);
+    return db;
+}
+
+// Carga una PatternDB según la extensión: ".pdb" binario (enlazado al blob de
+// openPdbSource), cualquier otra se interpreta como JSON.
+shared_ptr<const PatternDatabase> loadPatternDB(const string& filename, int boardSize) {
+    if (filename == BUILTIN_LINEAR_CONFLICT || filename == BUILTIN_WALKING_DISTANCE)
+        return builtinPatternDB(boardSize, filename == BUILTIN_WALKING_DISTANCE);
+    if (endsWith(filename, ".pdb"))
+        return parsePatternDBBinary(openPdbSource(filename), boardSize, false);
+    string jsonStr;
+    if (!readWholeFile(filename, jsonStr))
+        return nullptr;
+    return parsePatternDBJson(jsonStr, boardSize);
+}
+
+// Conversor del JSON existente (groups + patternDbDict) al formato binario
+bool convertPatternDBJsonToBinary(const string& jsonFilename, int boardSize, const string& outPath) {
+    string jsonStr;
+    if (!readWholeFile(jsonFilename, jsonStr))
+        return false;
+    shared_ptr<PatternDatabase> db = parsePatternDBJson(jsonStr, boardSize);
+    return db && writePatternDBBinary(*db, outPath);
+}
+
+// ------------------------------------------------------
+// Recodificación de tablas (ver PDB_ENCODING_* en pattern_db.h)
+// ------------------------------------------------------
+// Empaqueta los códigos de una tabla; false si alguna entrada no cabe
+bool encodePatternTable(const PatternGroup& group, int boardSize, int entryBits, uint32_t compression,
+                        vector<uint8_t>& out) {
+    int cells = boardSize * boardSize, k = (int)group.tiles.size();
+    if (group.entryBits == PDB_ENCODING_MOD3 || (group.compression != 1 && entryBits != PDB_ENCODING_BYTE)
+        || (entryBits == PDB_ENCODING_MOD3 && (group.entryBits != PDB_ENCODING_BYTE || !group.complete)))
+        return false;
+    out.assign(patternTableBytes(group.entries, entryBits, compression), entryBits == PDB_ENCODING_BYTE ? PDB_MISSING : 0);
+    int positions[PDB_MAX_GROUP_TILES];
+    for (uint64_t rank = 0; rank < group.entries; rank++){
+        unrankPattern(rank, k, cells, positions);
+        int manhattan = placementManhattan(group.tiles, positions, boardSize);
+        uint8_t code = patternCode(group, rank);
+        int value;
+        if (group.entryBits == PDB_ENCODING_BYTE)
+            value = code == PDB_MISSING ? -1 : code + (group.compression > 1 ? (manhattan - code) & 1 : 0);
+        else
+            value = code != PDB_NIBBLE_MISSING ? manhattan + 2 * code : -1;
+        switch (entryBits) {
+            case PDB_ENCODING_BYTE:
+                // Mínimo del bloque; PDB_MISSING es mayor que cualquier valor
+                if (value < 0)
+                    break;
+                if (compression > 1 && ((value - manhattan) & 1))
+                    return false;
+                out[rank / compression] = min(out[rank / compression], (uint8_t)value);
+                break;
+            case PDB_ENCODING_NIBBLE:
+                if (value >= 0) {
+                    int excess = value - manhattan;
+                    if (excess < 0 || (excess & 1) || excess / 2 >= PDB_NIBBLE_MISSING)
+                        return false;
+                    code = (uint8_t)(excess / 2);
+                } else {
+                    code = PDB_NIBBLE_MISSING;
+                }
+                out[rank >> 1] |= (uint8_t)(code << ((rank & 1) << 2));
+                break;
+            default: {
+                // Distancia exacta: todas las vecinas a +-1 y alguna a -1 salvo en el objetivo
+                bool consistent = true, descends = value == 0;
+                forEachPatternMove(positions, k, boardSize, [&](uint64_t next) {
+                    int diff = group.table[next] - value;
+                    consistent = diff == 1 || diff == -1;
+                    descends = descends || diff == -1;
+                    return !consistent;
+                });
+                if (!consistent || !descends || (value == 0) != (manhattan == 0))
+                    return false;
+                out[rank >> 2] |= (uint8_t)((value % 3) << ((rank & 3) << 1));
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+shared_ptr<PatternDatabase> encodePatternDB(const PatternDatabase& db, int entryBits, uint32_t compression) {
+    if ((entryBits != PDB_ENCODING_BYTE && entryBits != PDB_ENCODING_NIBBLE && entryBits != PDB_ENCODING_MOD3)
+        || compression == 0 || (compression > 1 && entryBits != PDB_ENCODING_BYTE))
+        return nullptr;
+    auto encoded = make_shared<PatternDatabase>();
+    encoded->boardSize = db.boardSize;
+    encoded->walkingDistance = db.walkingDistance;
+    for (const auto& group : db.groups){
+        vector<uint8_t> table;
+        if (group.table == nullptr || !encodePatternTable(group, db.boardSize, entryBits, compression, table))
+            return nullptr;
+        encoded->addOwnedGroup(group.tiles, std::move(table), entryBits, compression);
+    }
+    return encoded;
+}
+
+bool encodePatternDBFile(const string& filename, int boardSize, int entryBits, uint32_t compression,
+                         const string& outPath) {
+    shared_ptr<const PatternDatabase> db = loadPatternDB(filename, boardSize);
+    if (!db)
+        return false;
+    shared_ptr<PatternDatabase> encoded = encodePatternDB(*db, entryBits, compression);
+    return encoded && writePatternDBBinary(*encoded, outPath);
+}
+
+// ------------------------------------------------------
+// Registro de PatternDBs del proceso: cada (tamaño, archivo) se carga una
+// sola vez y las siguientes resoluciones reutilizan la misma instancia.
+// La última PatternDB precargada para un tamaño pasa a ser la usada por
+// defecto al resolver ese tamaño.
+// ------------------------------------------------------
+mutex g_patternDbMutex;
+map<pair<int, string>, shared_ptr<const PatternDatabase>> g_patternDbRegistry;
+map<int, shared_ptr<const PatternDatabase>> g_defaultPatternDb;
+
+shared_ptr<const PatternDatabase> acquirePatternDBLocked(const string& filename, int boardSize) {
+    auto key = make_pair(boardSize, filename);
+    auto it = g_patternDbRegistry.find(key);
+    if (it != g_patternDbRegistry.end())
+        return it->second;
+    // La carga ocurre bajo el mutex: llamadas concurrentes esperan a la primera
+    shared_ptr<const PatternDatabase> db = loadPatternDB(filename, boardSize);
+    if (db)
+        g_patternDbRegistry[key] = db;
+    return db;
+}
+
+shared_ptr<const PatternDatabase> acquirePatternDB(const string& filename, int boardSize) {
+    lock_guard<mutex> lock(g_patternDbMutex);
+    return acquirePatternDBLocked(filename, boardSize);
+}
+
+bool preloadPatternDB(const string& filename, int boardSize) {
+    lock_guard<mutex> lock(g_patternDbMutex);
+    shared_ptr<const PatternDatabase> db = acquirePatternDBLocked(filename, boardSize);
+    if (db)
+        g_defaultPatternDb[boardSize] = db;
+    return db != nullptr;
+}
+
+// PatternDB para resolver: la precargada o, si no hay, el asset
+// patternDb_<n>.pdb con el JSON patternDb_<n>.json como alternativa. Sin
+// ninguno de los dos se usa la heurística sin tablas (walking distance).
+shared_ptr<const PatternDatabase> defaultPatternDB(int boardSize) {
+    lock_guard<mutex> lock(g_patternDbMutex);
+    auto it = g_defaultPatternDb.find(boardSize);
+    if (it != g_defaultPatternDb.end())
+        return it->second;
+    string base = "patternDb_" + to_string(boardSize);
+    shared_ptr<const PatternDatabase> db = acquirePatternDBLocked(base + ".pdb", boardSize);
+    if (!db)
+        db = acquirePatternDBLocked(base + ".json", boardSize);
+    if (!db)
+        db = acquirePatternDBLocked(BUILTIN_WALKING_DISTANCE, boardSize);
+    if (db)
+        g_defaultPatternDb[boardSize] = db;
+    return db;
+}
+
+// Libera las PatternDBs registradas; las resoluciones en curso conservan su referencia
+void releasePatternDBs() {
+    lock_guard<mutex> lock(g_patternDbMutex);
+    g_patternDbRegistry.clear();
+    g_defaultPatternDb.clear();
+}
@@ -0,0 +1,187 @@
+// pattern_db.h
+// PatternDBs aditivas: ranking de patrones, carga (JSON y binario .pdb),
+// escritura del formato binario y registro de PatternDBs del proceso.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// ------------------------------------------------------
+// Índice denso de patrones: rango de una k-permutación de n celdas
+// positions[i] es la celda de la i-ésima ficha del grupo; el rango está en
+// [0, n!/(n-k)!) y distingue qué ficha ocupa cada celda.
+// ------------------------------------------------------
+uint64_t permutationCount(int n, int k);
+
+inline uint64_t rankPattern(const int* positions, int k, int n) {
+    uint64_t rank = 0;
+    uint32_t used = 0;
+    for (int i = 0; i < k; i++){
+        int cell = positions[i];
+        // Celdas libres con índice menor que la actual
+        int digit = cell - __builtin_popcount(used & ((1u << cell) - 1));
+        rank = rank * (uint64_t)(n - i) + (uint64_t)digit;
+        used |= 1u << cell;
+    }
+    return rank;
+}
+
+void unrankPattern(uint64_t rank, int k, int n, int* positions);
+
+// ------------------------------------------------------
+// PatternDB en memoria
+// ------------------------------------------------------
+const uint8_t PDB_MISSING = 0xFF; // entrada sin dato: se usa el valor de respaldo del grupo
+const int PDB_MAX_GROUP_TILES = 23;
+// Las celdas del tablero van en máscaras de 32 bits: PatternDBs de hasta 5x5
+const int PDB_MAX_BOARD_SIDE = 5;
+
+// Codificaciones de las tablas (bits por entrada)
+//   PDB_ENCODING_BYTE    el valor; PDB_MISSING si falta.
+//   PDB_ENCODING_NIBBLE  (valor - Manhattan del grupo) / 2; PDB_NIBBLE_MISSING
+//                        si falta. Cada movimiento de una ficha del grupo
+//                        cambia su Manhattan en 1, así que el exceso es par.
+//   PDB_ENCODING_MOD3    valor mod 3. Solo para tablas completas de distancias
+//                        exactas entre colocaciones (generadas con hueco libre,
+//                        ver pdb_generator.h): ahí mover una ficha cambia el
+//                        valor en exactamente 1 y el del hijo sale del padre.
+const int PDB_ENCODING_BYTE = 8;
+const int PDB_ENCODING_NIBBLE = 4;
+const int PDB_ENCODING_MOD3 = 2;
+const uint8_t PDB_NIBBLE_MISSING = 0xF;
+
+// Compresión con pérdida (solo tablas de bytes): cada entrada guardada cubre
+// compression rangos consecutivos y guarda el mínimo, que sigue siendo
+// admisible. Los rangos difieren primero en la celda de la última ficha del
+// grupo, así que compression = celdas - fichas + 1 equivale a ignorarla.
+// En las tablas generadas el valor tiene la paridad del Manhattan del grupo
+// (requisito para comprimir). Los rangos de una entrada guardada ponen la
+// última ficha en celdas distintas, así que su Manhattan no siempre tiene
+// la misma paridad y el mínimo puede tener la contraria a la del rango que
+// se lee: al leer se le suma 1 en ese caso, que sigue siendo admisible
+// porque el valor exacto tiene la paridad del Manhattan.
+
+// Si falta la entrada o el grupo no tiene tabla, su valor es Manhattan +
+// conflictos lineales de sus fichas, que sigue siendo aditivo.
+struct PatternGroup {
+    std::vector<int> tiles; // fichas del grupo en orden ascendente
+    uint32_t mask;          // bit t = ficha t
+    const uint8_t* table;   // indexada por rankPattern de las posiciones de tiles, o nullptr
+    uint64_t entries;
+    int entryBits = PDB_ENCODING_BYTE;
+    uint32_t compression = 1; // rangos por entrada guardada
+    bool complete = false;  // la tabla no tiene entradas sin dato
+};
+
+inline uint64_t patternTableBytes(uint64_t entries, int entryBits, uint32_t compression = 1) {
+    uint64_t stored = (entries + compression - 1) / compression;
+    return (stored * (uint64_t)entryBits + 7) / 8;
+}
+
+// Las tablas nibble y las comprimidas necesitan el Manhattan del grupo
+inline bool usesGroupManhattan(const PatternGroup &group) {
+    return group.entryBits == PDB_ENCODING_NIBBLE || group.compression > 1;
+}
+
+// Código guardado en la entrada rank (entradas empaquetadas desde el bit bajo)
+inline uint8_t patternCode(const PatternGroup &group, uint64_t rank) {
+    switch (group.entryBits) {
+        case PDB_ENCODING_NIBBLE: return (uint8_t)((group.table[rank >> 1] >> ((rank & 1) << 2)) & 0xF);
+        case PDB_ENCODING_MOD3: return (uint8_t)((group.table[rank >> 2] >> ((rank & 3) << 1)) & 3);
+        default: return group.table[group.compression == 1 ? rank : rank / group.compression];
+    }
+}
+
+// Valor de una entrada PDB_ENCODING_MOD3 a partir del valor del padre
+inline int decodeMod3(int parentValue, uint8_t code) {
+    return code == (uint8_t)((parentValue + 1) % 3) ? parentValue + 1 : parentValue - 1;
+}
+
+// Valor de una entrada PDB_ENCODING_MOD3 sin padre conocido (raíz de la
+// búsqueda): desciende hasta la colocación objetivo pasando siempre a una
+// vecina con valor uno menor y cuenta los pasos. positions[i] es la celda
+// de group.tiles[i].
+int mod3Distance(const PatternGroup &group, const int* positions, int boardSize);
+
+// Memoria de solo lectura que respalda las tablas (archivo mapeado o asset)
+class PdbBlob {
+public:
+    virtual ~PdbBlob() {}
+    virtual const uint8_t* data() const = 0;
+    virtual size_t size() const = 0;
+};
+
+// PatternDB cargada: inmutable una vez construida, se comparte entre hilos
+// mediante shared_ptr<const PatternDatabase>. Las tablas apuntan a
+// ownedTables (JSON convertido en memoria) o directamente a blob (binario).
+struct PatternDatabase {
+    int boardSize;
+    std::vector<PatternGroup> groups;
+    std::vector<std::vector<uint8_t>> ownedTables;
+    std::unique_ptr<PdbBlob> blob;
+    bool walkingDistance = false; // h = max(suma de grupos, walking distance)
+
+    // table ya codificada con entryBits y compression; boardSize debe estar fijado
+    void addOwnedGroup(const std::vector<int>& tiles, std::vector<uint8_t> table,
+                       int entryBits = PDB_ENCODING_BYTE, uint32_t compression = 1);
+};
+
+// Heurísticas sin tablas para cuando no hay PatternDB: un único grupo sin
+// tabla con todas las fichas (Manhattan + conflictos lineales) y, si se pide
+// y el tamaño lo permite, la walking distance
+const char BUILTIN_LINEAR_CONFLICT[] = "builtin:linear-conflict";
+const char BUILTIN_WALKING_DISTANCE[] = "builtin:walking-distance";
+
+std::shared_ptr<PatternDatabase> builtinPatternDB(int boardSize, bool walkingDistance);
+
+// ------------------------------------------------------
+// Fuentes de datos
+// Las rutas absolutas se mapean con mmap. Los nombres relativos se abren con
+// el AssetOpener instalado por la plataforma (assets del APK en Android) o,
+// si no hay ninguno, como archivos relativos al directorio actual.
+// ------------------------------------------------------
+typedef std::function<std::unique_ptr<PdbBlob>(const std::string& name)> AssetOpener;
+
+void setAssetOpener(AssetOpener opener);
+std::unique_ptr<PdbBlob> mapPdbFile(const std::string& path);
+std::unique_ptr<PdbBlob> openPdbSource(const std::string& name);
+
+// ------------------------------------------------------
+// Formatos
+// ------------------------------------------------------
+// JSON original: "groups" (arrays de fichas) y "patternDbDict"
+std::shared_ptr<PatternDatabase> parsePatternDBJson(const std::string& jsonStr, int boardSize);
+
+// Binario versión 1 (ver pattern_db.cpp). Las tablas apuntan al blob, sin copias.
+bool writePatternDBBinary(const PatternDatabase& db, const std::string& path);
+std::shared_ptr<PatternDatabase> parsePatternDBBinary(std::unique_ptr<PdbBlob> blob, int boardSize, bool verifyChecksum);
+
+// Copia de db con las tablas recodificadas a entryBits (PDB_ENCODING_*) y
+// comprimidas con compression (solo bytes). Retorna nullptr si alguna tabla
+// no lo admite: exceso sobre Manhattan impar (nibble y compresión) o mayor
+// que 28 (nibble), o tabla incompleta o que no cambia en exactamente 1 por movimiento (mod 3).
+// Las tablas mod 3 no se pueden recodificar y las comprimidas solo se
+// pueden recodificar a bytes.
+std::shared_ptr<PatternDatabase> encodePatternDB(const PatternDatabase& db, int entryBits, uint32_t compression = 1);
+bool encodePatternDBFile(const std::string& filename, int boardSize, int entryBits, uint32_t compression,
+                         const std::string& outPath);
+
+// Checksum de los formatos binarios
+uint32_t fnv1a(const uint8_t* data, size_t size, uint32_t hash = 2166136261u);
+
+// Carga según la extensión: ".pdb" binario, cualquier otra JSON. Los nombres
+// BUILTIN_* devuelven la heurística sin tablas correspondiente.
+std::shared_ptr<const PatternDatabase> loadPatternDB(const std::string& filename, int boardSize);
+bool convertPatternDBJsonToBinary(const std::string& jsonFilename, int boardSize, const std::string& outPath);
+
+// ------------------------------------------------------
+// Registro de PatternDBs del proceso
+// ------------------------------------------------------
+std::shared_ptr<const PatternDatabase> acquirePatternDB(const std::string& filename, int boardSize);
+bool preloadPatternDB(const std::string& filename, int boardSize);
+std::shared_ptr<const PatternDatabase> defaultPatternDB(int boardSize);
+void releasePatternDBs();
@@ -0,0 +1,297 @@
+// patterndb_c.cpp
+
+#include "patterndb_c.h"
+#include "anytime.h"
+#include "batch.h"
+#include "distance_table.h"
+#include "grid_solver.h"
+#include "ida_star.h"
+#include "pattern_db.h"
+#include "pdb_generator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+using namespace std;
+
+struct pdb_database {
+    shared_ptr<const PatternDatabase> db;
+};
+
+struct pdb_cancel_token {
+    CancellationToken token;
+};
+
+// Construye el Puzzle rows x cols si tiles es una permutación de 0..rows*cols-1
+bool puzzleFromTiles(const int* tiles, int rows, int cols, Puzzle &puzzle) {
+    if (tiles == nullptr || !isGridSupported(rows, cols))
+        return false;
+    int cells = rows * cols;
+    uint64_t seen = 0;
+    puzzle = Puzzle(rows, cols);
+    for (int cell = 0; cell < cells; cell++){
+        int tile = tiles[cell];
+        if (tile < 0 || tile >= cells || (seen & (1ULL << tile)))
+            return false;
+        seen |= 1ULL << tile;
+        puzzle.board[cell / cols][cell % cols] = tile;
+        if (tile == 0) {
+            puzzle.blankRow = cell / cols;
+            puzzle.blankCol = cell % cols;
+        }
+    }
+    return true;
+}
+
+pdb_status statusCode(SolveStatus status) {
+    switch (status) {
+        case SolveStatus::Solved: return PDB_STATUS_SOLVED;
+        case SolveStatus::InvalidInput: return PDB_STATUS_INVALID_INPUT;
+        case SolveStatus::Unsolvable: return PDB_STATUS_UNSOLVABLE;
+        case SolveStatus::Cancelled: return PDB_STATUS_CANCELLED;
+        case SolveStatus::Timeout: return PDB_STATUS_TIMEOUT;
+        case SolveStatus::BudgetExhausted: return PDB_STATUS_BUDGET_EXHAUSTED;
+        default: return PDB_STATUS_NO_SOLUTION;
+    }
+}
+
+void fillResult(const BatchResult &batch, pdb_solve_result* result) {
+    result->status = statusCode(batch.status);
+    result->length = (int)min(batch.moves.size(), (size_t)PDB_MAX_MOVES);
+    memcpy(result->moves, batch.moves.data(), (size_t)result->length);
+    result->moves[result->length] = '\0';
+    result->nodes = batch.nodes;
+    result->bound = batch.bound;
+    result->suboptimality = batch.suboptimality;
+    result->micros = batch.micros;
+    memset(result->reserved, 0, sizeof(result->reserved));
+}
+
+void failResult(pdb_status status, pdb_solve_result* result) {
+    memset(result, 0, sizeof(*result));
+    result->status = status;
+}
+
+// Resultado de una búsqueda que no pasa por solveOne
+BatchResult searchResult(const SearchStats &stats, const vector<pair<int,int>> &moves,
+                         chrono::steady_clock::time_point start) {
+    BatchResult batch;
+    batch.status = stats.status;
+    batch.nodes = stats.nodes;
+    batch.bound = stats.bound;
+    batch.suboptimality = stats.suboptimality;
+    for (const auto &move : moves){
+        size_t dir = find(Puzzle::DIRECTIONS.begin(), Puzzle::DIRECTIONS.end(), move) - Puzzle::DIRECTIONS.begin();
+        batch.moves.push_back(MOVE_LETTERS[dir]);
+    }
+    batch.micros = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    return batch;
+}
+
+// Opciones del llamador con los campos que su cabecera no tenía por defecto.
+// false si no se inicializaron (struct_size 0).
+bool readOptions(const pdb_options* options, pdb_options &out) {
+    pdb_options_init(&out);
+    if (options == nullptr)
+        return true;
+    if (options->struct_size < sizeof(options->struct_size))
+        return false;
+    memcpy(&out, options, min<size_t>(options->struct_size, sizeof(out)));
+    out.struct_size = sizeof(out);
+    return true;
+}
+
+SearchOptions searchOptions(const pdb_options &options) {
+    SearchOptions search;
+    search.reflect = options.reflect != 0;
+    search.limits.cancel = options.cancel != nullptr ? &options.cancel->token : nullptr;
+    search.limits.timeoutMicros = max<int64_t>(options.timeout_micros, 0);
+    search.limits.maxNodes = options.max_nodes;
+    search.orderMoves = options.order_moves != 0;
+    search.perimeterDepth = min(max(options.perimeter_depth, 0), Perimeter::MAX_DEPTH);
+    search.weight = min(max(options.weight, 1.0), MAX_SEARCH_WEIGHT);
+    if (options.transposition_mb > 0)
+        search.transpositionEntries = TranspositionTable::entriesForMegabytes((size_t)options.transposition_mb);
+    return search;
+}
+
+extern "C" {
+
+void pdb_options_init(pdb_options* options) {
+    if (options != nullptr) {
+        memset(options, 0, sizeof(*options));
+        options->struct_size = sizeof(*options);
+    }
+}
+
+pdb_cancel_token* pdb_cancel_token_create(void) {
+    return new pdb_cancel_token();
+}
+
+void pdb_cancel(pdb_cancel_token* token) {
+    if (token != nullptr)
+        token->token.cancel();
+}
+
+void pdb_cancel_token_destroy(pdb_cancel_token* token) {
+    delete token;
+}
+
+pdb_database* pdb_load(const char* path, int board_size) {
+    if (path == nullptr)
+        return nullptr;
+    shared_ptr<const PatternDatabase> db = acquirePatternDB(path, board_size);
+    return db ? new pdb_database{db} : nullptr;
+}
+
+pdb_database* pdb_default(int board_size) {
+    shared_ptr<const PatternDatabase> db = defaultPatternDB(board_size);
+    return db ? new pdb_database{db} : nullptr;
+}
+
+void pdb_release(pdb_database* db) {
+    delete db;
+}
+
+int pdb_generate(const char* partition, const char* out_path) {
+    if (partition == nullptr || out_path == nullptr)
+        return 0;
+    return generatePatternDBFile(partition, out_path) ? 1 : 0;
+}
+
+int pdb_generate_encoded(const char* partition, const char* out_path, int entry_bits) {
+    if (partition == nullptr || out_path == nullptr)
+        return 0;
+    return generatePatternDBFile(partition, out_path, entry_bits) ? 1 : 0;
+}
+
+int pdb_encode(const char* in_path, int board_size, const char* out_path, int entry_bits) {
+    if (in_path == nullptr || out_path == nullptr)
+        return 0;
+    return encodePatternDBFile(in_path, board_size, entry_bits, 1, out_path) ? 1 : 0;
+}
+
+int pdb_generate_compressed(const char* partition, const char* out_path, int compression) {
+    if (partition == nullptr || out_path == nullptr || compression < 1)
+        return 0;
+    return generatePatternDBFile(partition, out_path, PDB_ENCODING_BYTE, (uint32_t)compression) ? 1 : 0;
+}
+
+int pdb_compress(const char* in_path, int board_size, const char* out_path, int compression) {
+    if (in_path == nullptr || out_path == nullptr || compression < 1)
+        return 0;
+    return encodePatternDBFile(in_path, board_size, PDB_ENCODING_BYTE, (uint32_t)compression, out_path) ? 1 : 0;
+}
+
+int pdb_generate_distance_table(int rows, int cols, const char* out_path) {
+    if (out_path == nullptr)
+        return 0;
+    return generateDistanceTableFile(rows, cols, out_path) ? 1 : 0;
+}
+
+int pdb_preload_distance_table(int rows, int cols) {
+    return preloadDistanceTable(rows, cols) ? 1 : 0;
+}
+
+int pdb_convert(const char* json_path, int board_size, const char* out_path) {
+    if (json_path == nullptr || out_path == nullptr)
+        return 0;
+    return convertPatternDBJsonToBinary(json_path, board_size, out_path) ? 1 : 0;
+}
+
+pdb_status pdb_solve(const pdb_database* db, const int* tiles, int board_size, const pdb_options* options,
+                     pdb_solve_result* result) {
+    if (result == nullptr)
+        return PDB_STATUS_INVALID_INPUT;
+    pdb_options known;
+    Puzzle puzzle(PackedState::SIDE);
+    if (!readOptions(options, known) || board_size > PDB_MAX_BOARD_SIDE
+        || !puzzleFromTiles(tiles, board_size, board_size, puzzle)) {
+        failResult(PDB_STATUS_INVALID_INPUT, result);
+        return result->status;
+    }
+    if (!isSolvable(puzzle)) {
+        failResult(PDB_STATUS_UNSOLVABLE, result);
+        return result->status;
+    }
+    if (db == nullptr || !db->db || db->db->boardSize != board_size) {
+        failResult(PDB_STATUS_NO_DATABASE, result);
+        return result->status;
+    }
+    if (known.anytime) {
+        auto start = chrono::steady_clock::now();
+        SearchStats stats;
+        auto moves = anytimeSolve(puzzle, db->db.get(), searchOptions(known), &stats);
+        fillResult(searchResult(stats, moves, start), result);
+        return result->status;
+    }
+    if (board_size != PackedState::SIDE) {
+        // Otros lados: motor especializado del tamaño con la PatternDB
+        auto start = chrono::steady_clock::now();
+        SearchStats stats;
+        auto moves = solveGrid(puzzle, db->db.get(), searchOptions(known), &stats);
+        fillResult(searchResult(stats, moves, start), result);
+        return result->status;
+    }
+    if (!known.parallel) {
+        fillResult(solveOne(puzzle, *db->db, searchOptions(known)), result);
+        return result->status;
+    }
+    auto start = chrono::steady_clock::now();
+    SearchStats stats;
+    auto moves = parallelIDAStar(puzzle, *db->db, sharedPool(), searchOptions(known), &stats);
+    fillResult(searchResult(stats, moves, start), result);
+    return result->status;
+}
+
+pdb_status pdb_solve_grid(const int* tiles, int rows, int cols, const pdb_options* options,
+                          pdb_solve_result* result) {
+    if (result == nullptr)
+        return PDB_STATUS_INVALID_INPUT;
+    pdb_options known;
+    Puzzle puzzle(MIN_BOARD_SIDE);
+    if (!readOptions(options, known) || !puzzleFromTiles(tiles, rows, cols, puzzle)) {
+        failResult(PDB_STATUS_INVALID_INPUT, result);
+        return result->status;
+    }
+    auto start = chrono::steady_clock::now();
+    SearchStats stats;
+    auto moves = known.anytime ? anytimeSolve(puzzle, nullptr, searchOptions(known), &stats)
+                               : solveGrid(puzzle, searchOptions(known), &stats);
+    fillResult(searchResult(stats, moves, start), result);
+    return result->status;
+}
+
+void pdb_solve_batch(const pdb_database* db, const int* tiles, int count, int board_size,
+                     const pdb_options* options, pdb_solve_result* results) {
+    if (results == nullptr || count <= 0)
+        return;
+    pdb_options known;
+    bool validOptions = readOptions(options, known);
+    int cells = board_size * board_size;
+    vector<Puzzle> puzzles;
+    vector<int> slots; // índice en results de cada tablero válido
+    for (int i = 0; i < count; i++){
+        Puzzle puzzle(PackedState::SIDE);
+        if (!validOptions || board_size != PackedState::SIDE
+            || !puzzleFromTiles(tiles != nullptr ? tiles + (size_t)i * cells : nullptr, board_size, board_size, puzzle)) {
+            failResult(PDB_STATUS_INVALID_INPUT, &results[i]);
+        } else if (!isSolvable(puzzle)) {
+            failResult(PDB_STATUS_UNSOLVABLE, &results[i]);
+        } else if (db == nullptr || !db->db || db->db->boardSize != board_size) {
+            failResult(PDB_STATUS_NO_DATABASE, &results[i]);
+        } else {
+            puzzles.push_back(puzzle);
+            slots.push_back(i);
+        }
+    }
+    if (puzzles.empty())
+        return;
+    vector<BatchResult> batch = solveBatch(puzzles, *db->db, sharedPool(), searchOptions(known));
+    for (size_t i = 0; i < batch.size(); i++){
+        fillResult(batch[i], &results[slots[i]]);
+    }
+}
+
+}
@@ -0,0 +1,167 @@
+/* patterndb_c.h
+ * API C estable del solver (sin JNI ni Android). Los tableros se pasan como
+ * board_size * board_size (o rows * cols) enteros en orden fila-mayor con 0
+ * para el hueco.
+ * Los movimientos se devuelven como letras del hueco: D (abajo), U (arriba),
+ * R (derecha), L (izquierda).
+ * Compatibilidad: pdb_options empieza por su tamaño (struct_size, lo fija
+ * pdb_options_init) y solo crece por el final, así que un llamador compilado
+ * con una cabecera anterior sigue funcionando y los campos que no conoce
+ * toman su valor por defecto. pdb_solve_result tiene tamaño fijo: los campos
+ * nuevos ocupan reserved.
+ */
+#ifndef PATTERNDB_C_H
+#define PATTERNDB_C_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PDB_MAX_MOVES 256
+
+typedef struct pdb_database pdb_database;
+
+typedef enum {
+    PDB_STATUS_SOLVED = 0,
+    PDB_STATUS_NO_SOLUTION = 1,
+    PDB_STATUS_INVALID_INPUT = 2,
+    PDB_STATUS_NO_DATABASE = 3,
+    PDB_STATUS_UNSOLVABLE = 4,        /* paridad incompatible con el objetivo */
+    PDB_STATUS_CANCELLED = 5,         /* se canceló el pdb_cancel_token */
+    PDB_STATUS_TIMEOUT = 6,           /* se superó timeout_micros */
+    PDB_STATUS_BUDGET_EXHAUSTED = 7   /* se superó max_nodes */
+} pdb_status;
+
+/* Token de cancelación: pdb_cancel puede llamarse desde cualquier hilo y las
+ * resoluciones que lo usan terminan en pocos miles de nodos. */
+typedef struct pdb_cancel_token pdb_cancel_token;
+
+pdb_cancel_token* pdb_cancel_token_create(void);
+void pdb_cancel(pdb_cancel_token* token);
+void pdb_cancel_token_destroy(pdb_cancel_token* token);
+
+/* Opciones de resolución; inicializar con pdb_options_init */
+typedef struct {
+    uint32_t struct_size;       /* sizeof(pdb_options) del llamador; 0: opciones no
+                                   inicializadas (PDB_STATUS_INVALID_INPUT) */
+    int parallel;               /* != 0: reparte la búsqueda entre todos los núcleos */
+    int reflect;                /* != 0: PDB también sobre el tablero reflejado */
+    pdb_cancel_token* cancel;   /* NULL: sin cancelación */
+    int64_t timeout_micros;     /* 0: sin tiempo máximo (por tablero en lotes) */
+    uint64_t max_nodes;         /* 0: sin presupuesto de nodos (por tablero en lotes) */
+    int transposition_mb;       /* > 0: tabla de transposiciones de ese tamaño por
+                                   resolución secuencial (en lotes, por tablero) */
+    int order_moves;            /* != 0: hijos por f creciente (la última iteración
+                                   encuentra antes la solución) */
+    int perimeter_depth;        /* > 0: perímetro del objetivo con los estados a esa
+                                   distancia o menos (hasta 20; 16 son ~2 MB, se
+                                   genera una vez por proceso). Solo 4x4 */
+    double weight;              /* > 1: IDA* con f = g + weight * h (hasta 8): soluciones
+                                   de como mucho weight veces la óptima con muchos
+                                   menos nodos y sin tabla de transposiciones.
+                                   0 o 1: solución óptima */
+    int anytime;                /* != 0: solución rápida con peso (weight o 3) que se
+                                   mejora hasta timeout_micros / max_nodes o hasta
+                                   probar que es óptima; con un límite da la mejor
+                                   encontrada como SOLVED y su factor. Sin parallel
+                                   ni lotes */
+} pdb_options;
+
+typedef struct {
+    pdb_status status;
+    int length;                       /* movimientos en moves */
+    char moves[PDB_MAX_MOVES + 1];    /* terminado en '\0' */
+    uint64_t nodes;                   /* nodos generados (parciales si se detuvo) */
+    int bound;                        /* cota inferior de la longitud óptima */
+    double suboptimality;             /* length <= suboptimality * óptimo (1: óptima) */
+    int64_t micros;                   /* tiempo de resolución */
+    int64_t reserved[8];              /* para campos futuros; a 0 */
+} pdb_solve_result;
+
+/* Carga una PatternDB (.pdb binario o JSON) a través del registro del
+ * proceso: cargar dos veces el mismo archivo comparte las tablas. Los nombres
+ * "builtin:linear-conflict" y "builtin:walking-distance" dan heurísticas sin
+ * tablas. Retorna NULL si no se pudo cargar. */
+pdb_database* pdb_load(const char* path, int board_size);
+
+/* PatternDB por defecto del tamaño (la precargada, o patternDb_<n>.pdb /
+ * patternDb_<n>.json relativos al directorio actual, o la walking distance). */
+pdb_database* pdb_default(int board_size);
+
+void pdb_release(pdb_database* db);
+
+/* Genera una partición estándar ("5-5-5", "6-6-3" o "7-8" de 4x4, o
+ * "6-6-6-6" de 5x5: 4 tablas de 127.5M entradas, 510 MB) en out_path.
+ * 7-8 necesita 1.1 GB durante la generación y tarda unos 19 minutos en un
+ * núcleo; 6-6-6-6, algo más de 1 GB. Retorna 1 si se escribió el archivo. */
+int pdb_generate(const char* partition, const char* out_path);
+
+/* Como pdb_generate, con entry_bits bits por entrada: 8, 4 (exceso sobre
+ * Manhattan: mitad de memoria y los mismos valores) o 2 (valor mod 3 de
+ * tablas generadas con el hueco libre: un cuarto de memoria pero una
+ * heurística más débil; el valor exacto se reconstruye desde el del padre). */
+int pdb_generate_encoded(const char* partition, const char* out_path, int entry_bits);
+
+/* Recodifica una PatternDB (.pdb o JSON) a entry_bits bits por entrada (ver
+ * pdb_generate_encoded; 2 solo si sus tablas son distancias exactas entre
+ * colocaciones). Retorna 1 si se escribió el archivo. */
+int pdb_encode(const char* in_path, int board_size, const char* out_path, int entry_bits);
+
+/* Compresión con pérdida para dispositivos con poca memoria: cada entrada
+ * guardada cubre compression rangos consecutivos con su mínimo (sigue siendo
+ * admisible, con más nodos). compression = celdas - fichas + 1 ignora la
+ * celda de la última ficha de cada grupo. Solo tablas de 8 bits; el cargador
+ * lo lee de la cabecera. Retornan 1 si se escribió el archivo. */
+int pdb_generate_compressed(const char* partition, const char* out_path, int compression);
+int pdb_compress(const char* in_path, int board_size, const char* out_path, int compression);
+
+/* Genera la tabla de distancias exactas de un tablero rows x cols de hasta
+ * 12 celdas (BFS de todo el espacio de estados; 3x4 ocupa 120 MB, necesita
+ * 60 MB más durante la generación y tarda alrededor de minuto y medio). Con el
+ * nombre "distance_<rows>x<cols>.dst" en los assets o en el directorio
+ * actual, pdb_solve_grid resuelve ese tamaño por consulta. Retorna 1 si se
+ * escribió el archivo. */
+int pdb_generate_distance_table(int rows, int cols, const char* out_path);
+
+/* Prepara la tabla de distancias de rows x cols para pdb_solve_grid: la carga
+ * del archivo o, sin archivo y con hasta 10 celdas, la genera (2x5: ~0.5 s).
+ * pdb_solve_grid no genera tablas, así que ninguna resolución paga ese BFS.
+ * Retorna 1 si el tamaño tiene tabla. */
+int pdb_preload_distance_table(int rows, int cols);
+
+/* Convierte una PatternDB JSON al formato binario. Retorna 1 si tuvo éxito. */
+int pdb_convert(const char* json_path, int board_size, const char* out_path);
+
+/* Opciones por defecto: secuencial, sin reflejo ni límites, con struct_size */
+void pdb_options_init(pdb_options* options);
+
+/* Resuelve un tablero. options puede ser NULL (opciones por defecto); con
+ * struct_size 0 retorna PDB_STATUS_INVALID_INPUT. Los
+ * tableros sin solución se rechazan en O(n) con PDB_STATUS_UNSOLVABLE.
+ * Además de 4x4 admite PatternDBs de otros lados hasta 5x5 (p. ej.
+ * "6-6-6-6"); en esos tamaños se usan solo reflect, weight, anytime y los
+ * límites. */
+pdb_status pdb_solve(const pdb_database* db, const int* tiles, int board_size, const pdb_options* options,
+                     pdb_solve_result* result);
+
+/* Resuelve un tablero rows x cols (de 2 a 6 filas y columnas, también
+ * rectangulares) sin PatternDB, con Manhattan + conflictos lineales sobre el
+ * motor especializado para ese tamaño, o por descenso sobre la tabla de
+ * distancias exactas si el tamaño tiene una (del archivo o de
+ * pdb_preload_distance_table; entonces nodes es 0). Respeta cancel, timeout_micros,
+ * max_nodes, weight y anytime; el resto de las opciones se ignora. */
+pdb_status pdb_solve_grid(const int* tiles, int rows, int cols, const pdb_options* options,
+                          pdb_solve_result* result);
+
+/* Resuelve count tableros 4x4 consecutivos de tiles en el pool compartido,
+ * cada uno con el motor secuencial (options->parallel y anytime se ignoran). */
+void pdb_solve_batch(const pdb_database* db, const int* tiles, int count, int board_size,
+                     const pdb_options* options, pdb_solve_result* results);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PATTERNDB_C_H */
@@ -0,0 +1,215 @@
+// pdb_generator.cpp
+
+#include "pdb_generator.h"
+#include "puzzle.h"
+
+#include <algorithm>
+
+using namespace std;
+
+// ------------------------------------------------------
+// Generador de PatternDBs aditivas disjuntas (BFS retrógrado)
+// El estado abstracto es la colocación de las fichas del grupo más la región
+// de celdas libres donde está el hueco: mover el hueco dentro de su región no
+// mueve fichas del patrón y cuesta 0, y solo se cuentan los movimientos de
+// fichas del grupo, así que la suma de los grupos sigue siendo admisible.
+// Cada entrada guarda la distancia mínima sobre todas las regiones del hueco.
+// Con freeBlank se ignora la región: toda celda libre es alcanzable y la
+// tabla es la distancia exacta entre colocaciones, más débil pero
+// codificable mod 3 (ver PDB_ENCODING_MOD3).
+// ------------------------------------------------------
+struct BoardMasks {
+    int side;
+    int cells;
+    uint32_t all;        // todas las celdas
+    uint32_t notFirstCol; // celdas que no están en la primera columna
+    uint32_t notLastCol;  // celdas que no están en la última columna
+
+    explicit BoardMasks(int side) : side(side), cells(side * side) {
+        all = cells == 32 ? 0xFFFFFFFFu : (1u << cells) - 1;
+        notFirstCol = all;
+        notLastCol = all;
+        for (int row = 0; row < side; row++){
+            notFirstCol &= ~(1u << (row * side));
+            notLastCol &= ~(1u << (row * side + side - 1));
+        }
+    }
+
+    // Región conexa de celdas de free que contiene start
+    uint32_t flood(uint32_t start, uint32_t free) const {
+        uint32_t region = start;
+        while (true) {
+            uint32_t grown = region
+                             | (region >> side)
+                             | ((region << side) & all)
+                             | ((region << 1) & notFirstCol)
+                             | ((region >> 1) & notLastCol);
+            grown &= free;
+            if (grown == region)
+                return region;
+            region = grown;
+        }
+    }
+
+    // Celdas de free anteriores a la mínima de la región de start
+    int regionIndex(uint32_t start, uint32_t free) const {
+        uint32_t region = flood(start, free);
+        return __builtin_popcount(free & ((region & -region) - 1));
+    }
+};
+
+// Tabla de un grupo por BFS desde la colocación objetivo. Por rango, un bit
+// por región del hueco ya vista, indexada por el orden de su celda mínima
+// entre las celdas libres: VisitedMask debe tener al menos cells - k bits.
+// Cada capa es un bitmap de rangos (sin cola por estado): un rango de la
+// frontera expande todas sus regiones vistas. Las que no son de la capa
+// actual solo llevan a estados ya vistos, y así la memoria es la tabla, las
+// marcas de regiones y dos bits por rango. 7-8 en un núcleo: 1.1 GB de pico y
+// unos 19 minutos (5-5-5 y 6-6-3, segundos y pocos MB).
+template <typename VisitedMask>
+vector<uint8_t> generatePatternTableImpl(const vector<int>& tiles, int boardSize, bool freeBlank) {
+    BoardMasks masks(boardSize);
+    int cells = masks.cells;
+    const int deltas[4] = { boardSize, -boardSize, 1, -1 };
+    int k = (int)tiles.size();
+    uint64_t entries = permutationCount(cells, k);
+    vector<uint8_t> table(entries, PDB_MISSING);
+    vector<VisitedMask> visited(entries, 0);
+    vector<uint64_t> frontier((entries + 63) / 64, 0);
+    vector<uint64_t> next(frontier.size(), 0);
+
+    // Objetivo: ficha t en la celda t - 1, hueco en la última celda
+    int positions[32];
+    uint32_t occupied = 0;
+    for (int i = 0; i < k; i++){
+        positions[i] = tiles[i] - 1;
+        occupied |= 1u << positions[i];
+    }
+    uint64_t goalRank = rankPattern(positions, k, cells);
+    uint32_t goalFree = masks.all & ~occupied;
+    table[goalRank] = 0;
+    visited[goalRank] = (VisitedMask)1 << (freeBlank ? 0 : masks.regionIndex(1u << (cells - 1), goalFree));
+    frontier[goalRank >> 6] |= 1ULL << (goalRank & 63);
+
+    for (int depth = 0; ; depth++){
+        bool expanded = false;
+        for (size_t word = 0; word < frontier.size(); word++){
+            for (uint64_t bits = frontier[word]; bits != 0; bits &= bits - 1){
+                uint64_t source = (word << 6) | (uint64_t)__builtin_ctzll(bits);
+                expanded = true;
+                unrankPattern(source, k, cells, positions);
+                occupied = 0;
+                for (int i = 0; i < k; i++){
+                    occupied |= 1u << positions[i];
+                }
+                uint32_t free = masks.all & ~occupied;
+                // Regiones vistas del rango: la celda libre número index de
+                // cada bit es la mínima de su región
+                VisitedMask seen = visited[source];
+                int index = 0;
+                for (uint32_t rest = free; rest != 0; rest &= rest - 1, index++){
+                    if (!(seen & ((VisitedMask)1 << index)))
+                        continue;
+                    uint32_t cell = rest & -rest;
+                    uint32_t region = freeBlank ? free : masks.flood(cell, free);
+                    for (int i = 0; i < k; i++){
+                        int from = positions[i];
+                        int col = from % boardSize;
+                        for (int d = 0; d < 4; d++){
+                            // Mismo orden que Puzzle::DIRECTIONS: abajo, arriba, derecha, izquierda
+                            if ((d == 0 && from + boardSize >= cells) || (d == 1 && from < boardSize)
+                                || (d == 2 && col == boardSize - 1) || (d == 3 && col == 0))
+                                continue;
+                            int to = from + deltas[d];
+                            if (!(region & (1u << to)))
+                                continue;
+                            // La ficha pasa a "to" y el hueco queda en "from"
+                            positions[i] = to;
+                            uint32_t nextFree = (free & ~(1u << to)) | (1u << from);
+                            int nextIndex = freeBlank ? 0 : masks.regionIndex(1u << from, nextFree);
+                            uint64_t rank = rankPattern(positions, k, cells);
+                            positions[i] = from;
+                            VisitedMask bit = (VisitedMask)1 << nextIndex;
+                            if (visited[rank] & bit)
+                                continue;
+                            visited[rank] |= bit;
+                            if (table[rank] == PDB_MISSING)
+                                table[rank] = (uint8_t)(depth + 1);
+                            next[rank >> 6] |= 1ULL << (rank & 63);
+                        }
+                    }
+                }
+            }
+        }
+        if (!expanded)
+            break;
+        frontier.swap(next);
+        fill(next.begin(), next.end(), 0);
+    }
+    return table;
+}
+
+vector<uint8_t> generatePatternTable(const vector<int>& tiles, int boardSize, bool freeBlank) {
+    int freeCells = boardSize * boardSize - (int)tiles.size();
+    if (freeCells <= 8)
+        return generatePatternTableImpl<uint8_t>(tiles, boardSize, freeBlank);
+    if (freeCells <= 16)
+        return generatePatternTableImpl<uint16_t>(tiles, boardSize, freeBlank);
+    return generatePatternTableImpl<uint32_t>(tiles, boardSize, freeBlank);
+}
+
+// Particiones estándar. Ninguna es cerrada bajo el reflejo: si lo fuera, la
+// suma sobre el tablero reflejado sería siempre igual a la directa.
+bool standardPartition(const string& name, vector<vector<int>>& groups, int& boardSize) {
+    boardSize = 4;
+    if (name == "5-5-5") {
+        groups = { {1, 2, 3, 5, 6}, {4, 7, 8, 11, 12}, {9, 10, 13, 14, 15} };
+    } else if (name == "6-6-3") {
+        groups = { {1, 5, 6, 9, 10, 13}, {7, 8, 11, 12, 14, 15}, {2, 3, 4} };
+    } else if (name == "7-8") {
+        groups = { {1, 2, 3, 4, 5, 6, 7, 8}, {9, 10, 11, 12, 13, 14, 15} };
+    } else if (name == "6-6-6-6") {
+        boardSize = 5;
+        groups = { {1, 2, 3, 6, 7, 8}, {4, 5, 9, 10, 14, 15}, {11, 12, 16, 17, 21, 22}, {13, 18, 19, 20, 23, 24} };
+    } else {
+        return false;
+    }
+    return true;
+}
+
+shared_ptr<PatternDatabase> generatePatternDB(const vector<vector<int>>& groups, int boardSize, bool freeBlank) {
+    int cells = boardSize * boardSize;
+    if (boardSize < MIN_BOARD_SIDE || boardSize > PDB_MAX_BOARD_SIDE)
+        return nullptr;
+    // Los grupos deben ser disjuntos y no incluir el hueco para ser aditivos
+    uint32_t seen = 0;
+    for (const auto& group : groups){
+        if (group.empty() || (int)group.size() > PDB_MAX_GROUP_TILES)
+            return nullptr;
+        for (int tile : group){
+            if (tile <= 0 || tile >= cells || (seen & (1u << tile)))
+                return nullptr;
+            seen |= 1u << tile;
+        }
+    }
+    auto db = make_shared<PatternDatabase>();
+    db->boardSize = boardSize;
+    for (const auto& group : groups){
+        vector<int> tiles = group;
+        sort(tiles.begin(), tiles.end());
+        db->addOwnedGroup(tiles, generatePatternTable(tiles, boardSize, freeBlank));
+    }
+    return db;
+}
+
+// Genera la partición indicada (ver standardPartition) y la escribe en formato binario
+bool generatePatternDBFile(const string& partition, const string& outPath, int entryBits, uint32_t compression) {
+    vector<vector<int>> groups;
+    int boardSize;
+    if (!standardPartition(partition, groups, boardSize))
+        return false;
+    shared_ptr<PatternDatabase> db = generatePatternDB(groups, boardSize, entryBits == PDB_ENCODING_MOD3);
+    if (db && (entryBits != PDB_ENCODING_BYTE || compression != 1))
+        db = encodePatternDB(*db, entryBits, compression);
+    return db && writePatternDBBinary(*db, outPath);
+}
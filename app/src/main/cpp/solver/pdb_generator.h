@@ -0,0 +1,29 @@
+// pdb_generator.h
+// Generación de PatternDBs aditivas disjuntas por BFS retrógrado.
+#pragma once
+
+#include "pattern_db.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// Tabla de un grupo de fichas (indexada por rankPattern). Con freeBlank el
+// hueco se ignora: distancias exactas entre colocaciones, menores pero
+// codificables mod 3.
+std::vector<uint8_t> generatePatternTable(const std::vector<int>& tiles, int boardSize, bool freeBlank = false);
+
+// Particiones estándar: "5-5-5", "6-6-3" o "7-8" (4x4) y "6-6-6-6" (5x5).
+// boardSize recibe el lado del tablero de la partición.
+bool standardPartition(const std::string& name, std::vector<std::vector<int>>& groups, int& boardSize);
+
+// Los grupos deben ser disjuntos y no incluir el hueco (ficha 0)
+std::shared_ptr<PatternDatabase> generatePatternDB(const std::vector<std::vector<int>>& groups, int boardSize,
+                                                  bool freeBlank = false);
+
+// Genera una partición estándar y la escribe en formato binario con
+// entryBits por entrada (PDB_ENCODING_*; mod 3 se genera con hueco libre) y
+// la compresión con pérdida indicada (solo bytes). La tabla completa se
+// genera en memoria antes de comprimirla.
+bool generatePatternDBFile(const std::string& partition, const std::string& outPath,
+                           int entryBits = PDB_ENCODING_BYTE, uint32_t compression = 1);
@@ -0,0 +1,91 @@
+// perimeter.cpp
+
+#include "perimeter.h"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+using namespace std;
+
+Perimeter::Perimeter(int depth) : maxDepth(depth) {
+    PackedState goal;
+    goal.tiles = PackedState::GOAL;
+    goal.blank = PackedState::CELLS - 1;
+    vector<PackedState> layer(1, goal);
+    vector<uint64_t> previous;  // capa anterior, ordenada
+    vector<pair<uint64_t, uint8_t>> all(1, make_pair(goal.tiles, (uint8_t)0));
+    for (int d = 1; d <= depth; d++){
+        vector<PackedState> next;
+        for (const PackedState &state : layer){
+            for (int dir = 0; dir < 4; dir++){
+                if (!state.canMove(dir))
+                    continue;
+                PackedState child = state;
+                child.applyMove(dir);
+                if (!binary_search(previous.begin(), previous.end(), child.tiles))
+                    next.push_back(child);
+            }
+        }
+        sort(next.begin(), next.end(), [](const PackedState &a, const PackedState &b) { return a.tiles < b.tiles; });
+        next.erase(unique(next.begin(), next.end(),
+                          [](const PackedState &a, const PackedState &b) { return a.tiles == b.tiles; }),
+                   next.end());
+        previous.clear();
+        for (const PackedState &state : layer){
+            previous.push_back(state.tiles);
+        }
+        sort(previous.begin(), previous.end());
+        for (const PackedState &state : next){
+            all.push_back(make_pair(state.tiles, (uint8_t)d));
+        }
+        layer.swap(next);
+    }
+    sort(all.begin(), all.end());
+    keys.reserve(all.size());
+    distances.reserve(all.size());
+    for (const auto &entry : all){
+        keys.push_back(entry.first);
+        distances.push_back(entry.second);
+    }
+}
+
+int Perimeter::distance(uint64_t tiles) const {
+    auto it = lower_bound(keys.begin(), keys.end(), tiles);
+    if (it == keys.end() || *it != tiles)
+        return -1;
+    return distances[it - keys.begin()];
+}
+
+bool Perimeter::appendPathToGoal(PackedState state, MovePath &path) const {
+    int remaining = distance(state.tiles);
+    if (path.length + remaining > MovePath::MAX_DEPTH)
+        return false;
+    for (int d = remaining; d > 0; d--){
+        for (int dir = 0; dir < 4; dir++){
+            if (!state.canMove(dir))
+                continue;
+            PackedState child = state;
+            child.applyMove(dir);
+            if (distance(child.tiles) == d - 1) {
+                path.push(dir);
+                state = child;
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+shared_ptr<const Perimeter> Perimeter::forDepth(int depth) {
+    if (depth < 1 || depth > MAX_DEPTH)
+        return nullptr;
+    // La generación ocurre bajo el mutex: llamadas concurrentes esperan a la primera
+    static mutex perimetersMutex;
+    static map<int, shared_ptr<const Perimeter>> perimeters;
+    lock_guard<mutex> lock(perimetersMutex);
+    shared_ptr<const Perimeter> &perimeter = perimeters[depth];
+    if (!perimeter)
+        perimeter = make_shared<Perimeter>(depth);
+    return perimeter;
+}
@@ -0,0 +1,54 @@
+// perimeter.h
+// Perímetro del objetivo 4x4: todos los estados a distancia <= depth con su
+// distancia exacta, para la búsqueda con perímetro de IDAStarEngine.
+#pragma once
+
+#include "puzzle.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// ------------------------------------------------------
+// Se genera por BFS desde el objetivo, capa por capa: el grafo es
+// bipartito, así que los vecinos de la capa d están en d - 1 o d + 1 y
+// basta con descartar los de la capa anterior. Los estados se guardan como
+// PackedState::tiles (el hueco es el nibble a 0) en un array ordenado, con
+// la distancia en un array paralelo; la consulta es una búsqueda binaria.
+// Con depth 16 son unos 250K estados (2.3 MB).
+// ------------------------------------------------------
+class Perimeter {
+public:
+    static constexpr int MAX_DEPTH = 20;
+
+    explicit Perimeter(int depth);
+
+    Perimeter(const Perimeter&) = delete;
+    Perimeter& operator=(const Perimeter&) = delete;
+
+    // Perímetro compartido del proceso (se genera la primera vez); nullptr si
+    // depth no está en [1, MAX_DEPTH]
+    static std::shared_ptr<const Perimeter> forDepth(int depth);
+
+    int depth() const {
+        return maxDepth;
+    }
+
+    size_t size() const {
+        return keys.size();
+    }
+
+    // Distancia exacta al objetivo, o -1 si el estado está fuera del perímetro
+    int distance(uint64_t tiles) const;
+
+    // Movimientos del hueco desde un estado del perímetro hasta el objetivo
+    // (siempre hacia un vecino con distancia uno menor). false, sin tocar
+    // path, si no caben en MovePath::MAX_DEPTH.
+    bool appendPathToGoal(PackedState state, MovePath &path) const;
+
+private:
+    int maxDepth;
+    std::vector<uint64_t> keys;     // ordenadas
+    std::vector<uint8_t> distances;
+};
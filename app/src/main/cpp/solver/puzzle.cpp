@@ -0,0 +1,104 @@
+// puzzle.cpp
+
+#include "puzzle.h"
+
+using namespace std;
+
+const vector<pair<int,int>> Puzzle::DIRECTIONS = { {1,0}, {-1,0}, {0,1}, {0,-1} };
+
+const char MOVE_LETTERS[] = "DURL";
+
+// ------------------------------------------------------
+// Reconstruye el camino de estados (cada matriz) a partir de los movimientos
+// ------------------------------------------------------
+vector<string> reconstructPath(const Puzzle &initial, const vector<pair<int,int>> &moves) {
+    vector<string> states;
+    Puzzle temp = initial;
+    states.push_back(temp.toString());
+    for (auto move : moves) {
+        temp.move(move.first, move.second);
+        states.push_back(temp.toString());
+    }
+    return states;
+}
+
+bool hasValidTiles(const Puzzle &puzzle) {
+    int cells = puzzle.rows * puzzle.cols;
+    vector<bool> seen(cells, false);
+    for (const auto &row : puzzle.board) {
+        for (int tile : row) {
+            if (tile < 0 || tile >= cells || seen[tile])
+                return false;
+            seen[tile] = true;
+        }
+    }
+    return puzzle.board[puzzle.blankRow][puzzle.blankCol] == 0;
+}
+
+bool isSolvable(const Puzzle &puzzle) {
+    int rows = puzzle.rows, cols = puzzle.cols, cells = rows * cols;
+    // target[celda] = celda objetivo de la ficha que la ocupa (hueco al final)
+    vector<int> target(cells);
+    for (int cell = 0; cell < cells; cell++){
+        int tile = puzzle.board[cell / cols][cell % cols];
+        target[cell] = tile == 0 ? cells - 1 : tile - 1;
+    }
+    int cycles = 0;
+    vector<bool> visited(cells, false);
+    for (int cell = 0; cell < cells; cell++){
+        if (visited[cell])
+            continue;
+        cycles++;
+        for (int c = cell; !visited[c]; c = target[c]){
+            visited[c] = true;
+        }
+    }
+    int permutationParity = (cells - cycles) & 1;
+    int blankDistance = (rows - 1 - puzzle.blankRow) + (cols - 1 - puzzle.blankCol);
+    return permutationParity == (blankDistance & 1);
+}
+
+// ------------------------------------------------------
+// Parsea la entrada en una matriz de MIN_BOARD_SIDE a MAX_BOARD_SIDE filas y columnas
+// Formato: "1 2 3 4;5 6 7 8;9 10 11 12;13 14 15 0" (filas separadas por ';')
+// ------------------------------------------------------
+bool parsePuzzle(const string& input, Puzzle& puzzle, string& error) {
+    vector<vector<int>> matrix;
+    istringstream iss(input);
+    string rowStr;
+    while(getline(iss, rowStr, ';')) {
+        istringstream rowStream(rowStr);
+        vector<int> row;
+        int val;
+        while(rowStream >> val) {
+            row.push_back(val);
+        }
+        matrix.push_back(row);
+    }
+    int rows = (int)matrix.size(), cols = rows > 0 ? (int)matrix[0].size() : 0;
+    bool rectangular = rows >= MIN_BOARD_SIDE && rows <= MAX_BOARD_SIDE
+                       && cols >= MIN_BOARD_SIDE && cols <= MAX_BOARD_SIDE;
+    for (const auto &row : matrix) {
+        if ((int)row.size() != cols)
+            rectangular = false;
+    }
+    if (!rectangular) {
+        error = "Error: La matriz debe tener de 2 a 6 filas y columnas, todas del mismo largo.";
+        return false;
+    }
+    puzzle = Puzzle(rows, cols);
+    for (int i = 0; i < rows; i++){
+        for (int j = 0; j < cols; j++){
+            puzzle.board[i][j] = matrix[i][j];
+            if(matrix[i][j] == 0){
+                puzzle.blankRow = i;
+                puzzle.blankCol = j;
+            }
+        }
+    }
+    if (!hasValidTiles(puzzle)) {
+        error = "Error: La matriz debe contener los números 0 a " + to_string(rows * cols - 1) + " sin repetir.";
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,268 @@
+// puzzle.h
+// Representaciones del tablero: Puzzle (matriz, para entrada y salida) y
+// PackedState (compacto, para la búsqueda), más el camino de movimientos.
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// Tableros admitidos: de 2 a 6 filas y columnas
+const int MIN_BOARD_SIDE = 2;
+const int MAX_BOARD_SIDE = 6;
+
+// ------------------------------------------------------
+// Clase Puzzle (rows x cols; el objetivo es 1..n-1 en orden fila-mayor con
+// el hueco en la última celda)
+// ------------------------------------------------------
+class Puzzle {
+public:
+    int rows, cols;
+    std::vector<std::vector<int>> board;
+    int blankRow, blankCol;
+
+    // Direcciones: abajo, arriba, derecha, izquierda
+    static const std::vector<std::pair<int,int>> DIRECTIONS;
+
+    explicit Puzzle(int boardSize) : Puzzle(boardSize, boardSize) {}
+
+    Puzzle(int rows, int cols) : rows(rows), cols(cols) {
+        board.resize(rows, std::vector<int>(cols));
+        for (int i = 0; i < rows; i++){
+            for (int j = 0; j < cols; j++){
+                board[i][j] = i * cols + j + 1;
+            }
+        }
+        blankRow = rows - 1;
+        blankCol = cols - 1;
+        board[blankRow][blankCol] = 0;
+    }
+
+    // Constructor copia
+    Puzzle(const Puzzle &other) {
+        rows = other.rows;
+        cols = other.cols;
+        board = other.board;
+        blankRow = other.blankRow;
+        blankCol = other.blankCol;
+    }
+
+    Puzzle& operator=(const Puzzle &other) {
+        if (this != &other) {
+            rows = other.rows;
+            cols = other.cols;
+            board = other.board;
+            blankRow = other.blankRow;
+            blankCol = other.blankCol;
+        }
+        return *this;
+    }
+
+    // Comprueba si el puzzle está resuelto
+    bool checkWin() const {
+        for (int i = 0; i < rows; i++){
+            for (int j = 0; j < cols; j++){
+                if (i == rows - 1 && j == cols - 1)
+                    continue;
+                if (board[i][j] != i * cols + j + 1)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    // Mueve la celda vacía en la dirección (dx, dy)
+    bool move(int dx, int dy) {
+        int newRow = blankRow + dx;
+        int newCol = blankCol + dy;
+        if (newRow < 0 || newRow >= rows || newCol < 0 || newCol >= cols)
+            return false;
+        board[blankRow][blankCol] = board[newRow][newCol];
+        board[newRow][newCol] = 0;
+        blankRow = newRow;
+        blankCol = newCol;
+        return true;
+    }
+
+    // Simula un movimiento y retorna (bool, Puzzle)
+    std::pair<bool, Puzzle> simulateMove(const std::pair<int,int>& dir) const {
+        Puzzle sim(*this);
+        bool valid = sim.move(dir.first, dir.second);
+        return std::make_pair(valid, sim);
+    }
+
+    // Genera un hash del estado considerando sólo las piezas en "group"
+    std::string hash(const std::unordered_set<int>& group) const {
+        std::ostringstream oss;
+        for (int i = 0; i < rows; i++){
+            for (int j = 0; j < cols; j++){
+                int tile = board[i][j];
+                if (group.find(tile) != group.end()){
+                    oss << i << j;  // Un dígito: como mucho MAX_BOARD_SIDE filas y columnas
+                }
+            }
+        }
+        return oss.str();
+    }
+
+    // Representa el estado en forma de cadena
+    std::string toString() const {
+        std::ostringstream oss;
+        for (int i = 0; i < rows; i++){
+            for (int j = 0; j < cols; j++){
+                oss << board[i][j] << "\t";
+            }
+            oss << "\n";
+        }
+        return oss.str();
+    }
+};
+
+// ------------------------------------------------------
+// Estado compacto 4x4: 16 nibbles en un uint64_t + índice del hueco
+// El nibble i (bits 4i..4i+3) guarda la ficha de la celda i en orden
+// fila-mayor. Se copia por valor y vive en registros durante la búsqueda;
+// Puzzle queda como adaptador para parsear la entrada y para toString().
+// ------------------------------------------------------
+struct PackedState {
+    static const int SIDE = 4;
+    static const int CELLS = SIDE * SIDE;
+    // 1 2 3 ... 15 0 -> nibble i = i + 1, último nibble = 0
+    static const uint64_t GOAL = 0x0FEDCBA987654321ULL;
+    // Desplazamiento de celda para cada índice de Puzzle::DIRECTIONS
+    static constexpr int OFFSETS[4] = { SIDE, -SIDE, 1, -1 };
+
+    uint64_t tiles;
+    int blank;
+
+    int tileAt(int cell) const {
+        return (int)((tiles >> (cell << 2)) & 0xF);
+    }
+
+    bool isGoal() const {
+        return tiles == GOAL;
+    }
+
+    // Indica si el hueco puede moverse en la dirección dirIndex
+    bool canMove(int dirIndex) const {
+        switch (dirIndex) {
+            case 0: return blank < CELLS - SIDE;      // abajo
+            case 1: return blank >= SIDE;             // arriba
+            case 2: return (blank & (SIDE - 1)) != SIDE - 1; // derecha
+            default: return (blank & (SIDE - 1)) != 0;       // izquierda
+        }
+    }
+
+    // Mueve el hueco sin comprobar límites: la ficha vecina pasa a la celda del hueco
+    void applyMove(int dirIndex) {
+        int target = blank + OFFSETS[dirIndex];
+        uint64_t tile = (tiles >> (target << 2)) & 0xF;
+        tiles &= ~(0xFULL << (target << 2));
+        tiles |= tile << (blank << 2);
+        blank = target;
+    }
+
+    bool move(int dirIndex) {
+        if (!canMove(dirIndex))
+            return false;
+        applyMove(dirIndex);
+        return true;
+    }
+
+    // El hueco queda implícito en el nibble a 0, así que tiles identifica el estado
+    uint64_t hashKey() const {
+        uint64_t h = tiles;
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    static PackedState fromPuzzle(const Puzzle &puzzle) {
+        PackedState state;
+        state.tiles = 0;
+        state.blank = puzzle.blankRow * SIDE + puzzle.blankCol;
+        for (int i = 0; i < SIDE; i++){
+            for (int j = 0; j < SIDE; j++){
+                state.tiles |= (uint64_t)(puzzle.board[i][j] & 0xF) << ((i * SIDE + j) << 2);
+            }
+        }
+        return state;
+    }
+
+    Puzzle toPuzzle() const {
+        Puzzle puzzle(SIDE);
+        for (int cell = 0; cell < CELLS; cell++){
+            puzzle.board[cell / SIDE][cell % SIDE] = tileAt(cell);
+        }
+        puzzle.blankRow = blank / SIDE;
+        puzzle.blankCol = blank % SIDE;
+        return puzzle;
+    }
+};
+
+// ------------------------------------------------------
+// Camino de movimientos: 2 bits por movimiento (índice en Puzzle::DIRECTIONS)
+// ------------------------------------------------------
+struct MovePath {
+    static constexpr int MAX_DEPTH = 256;
+
+    uint64_t words[MAX_DEPTH / 32];
+    int length = 0;
+
+    void push(int dirIndex) {
+        assert(length < MAX_DEPTH);
+        int word = length >> 5, shift = (length & 31) << 1;
+        words[word] = (words[word] & ~(3ULL << shift)) | ((uint64_t)dirIndex << shift);
+        length++;
+    }
+
+    void pop() {
+        length--;
+    }
+
+    int at(int i) const {
+        return (int)((words[i >> 5] >> ((i & 31) << 1)) & 3);
+    }
+
+    int last() const {
+        return at(length - 1);
+    }
+
+    std::vector<std::pair<int,int>> toDirections() const {
+        std::vector<std::pair<int,int>> moves;
+        moves.reserve(length);
+        for (int i = 0; i < length; i++){
+            moves.push_back(Puzzle::DIRECTIONS[at(i)]);
+        }
+        return moves;
+    }
+};
+
+// Las direcciones van en pares opuestos (abajo/arriba, derecha/izquierda)
+inline int oppositeDirection(int dirIndex) {
+    return dirIndex ^ 1;
+}
+
+// Letra de cada dirección de Puzzle::DIRECTIONS (movimiento del hueco)
+extern const char MOVE_LETTERS[];
+
+// Las fichas son exactamente 0..rows*cols-1 sin repetir
+bool hasValidTiles(const Puzzle &puzzle);
+
+// Cada movimiento es una trasposición con el hueco y cambia en 1 su
+// distancia Manhattan al objetivo, así que un tablero válido tiene solución
+// si y solo si la paridad de su permutación coincide con la de esa
+// distancia. O(n) contando ciclos.
+bool isSolvable(const Puzzle &puzzle);
+
+// Parsea la entrada en una matriz de MIN_BOARD_SIDE a MAX_BOARD_SIDE filas y columnas
+// Formato: "1 2 3 4;5 6 7 8;9 10 11 12;13 14 15 0" (filas separadas por ';')
+bool parsePuzzle(const std::string& input, Puzzle& puzzle, std::string& error);
+
+// Reconstruye el camino de estados (cada matriz) a partir de los movimientos
+std::vector<std::string> reconstructPath(const Puzzle &initial, const std::vector<std::pair<int,int>> &moves);
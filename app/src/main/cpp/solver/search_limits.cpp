@@ -0,0 +1,29 @@
+// search_limits.cpp
+
+#include "search_limits.h"
+
+using namespace std;
+
+SearchBudget::SearchBudget(const SearchLimits &limits)
+        : limits(limits), deadline(chrono::steady_clock::now() + chrono::microseconds(limits.timeoutMicros)) {
+}
+
+bool SearchBudget::charge(uint64_t count) {
+    uint64_t total = nodes.fetch_add(count, memory_order_relaxed) + count;
+    if (stopped())
+        return false;
+    if (limits.cancel != nullptr && limits.cancel->isCancelled())
+        return stop(SolveStatus::Cancelled);
+    if (limits.maxNodes > 0 && total >= limits.maxNodes)
+        return stop(SolveStatus::BudgetExhausted);
+    if (limits.timeoutMicros > 0 && chrono::steady_clock::now() >= deadline)
+        return stop(SolveStatus::Timeout);
+    return true;
+}
+
+// Conserva el primer motivo si varios motores paran a la vez
+bool SearchBudget::stop(SolveStatus status) {
+    SolveStatus expected = SolveStatus::Solved;
+    stopReason.compare_exchange_strong(expected, status, memory_order_relaxed);
+    return false;
+}
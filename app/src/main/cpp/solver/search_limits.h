@@ -0,0 +1,75 @@
+// search_limits.h
+// Límites cooperativos de una resolución: cancelación, tiempo máximo y
+// presupuesto de nodos. Los motores los consultan cada pocos miles de nodos.
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Resultado de una resolución
+enum class SolveStatus {
+    Solved,
+    NoSolution,     // se agotó la búsqueda (límite de profundidad)
+    InvalidInput,   // el tablero no es una permutación de 0..n*n-1
+    Unsolvable,     // la paridad no permite llegar al objetivo
+    Cancelled,      // se activó el CancellationToken
+    Timeout,        // se superó SearchLimits::timeoutMicros
+    BudgetExhausted // se superó SearchLimits::maxNodes
+};
+
+// Token de cancelación: lo activa otro hilo (UI, servidor) y la búsqueda lo
+// observa en su siguiente comprobación
+class CancellationToken {
+public:
+    void cancel() {
+        cancelled.store(true, std::memory_order_relaxed);
+    }
+
+    bool isCancelled() const {
+        return cancelled.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<bool> cancelled{false};
+};
+
+// Límites de una resolución (0 o nullptr: sin límite). En un lote cada
+// tablero tiene su propio tiempo y presupuesto; el token es común.
+struct SearchLimits {
+    const CancellationToken* cancel = nullptr;
+    int64_t timeoutMicros = 0;
+    uint64_t maxNodes = 0;
+};
+
+// ------------------------------------------------------
+// Contabilidad de una resolución frente a sus límites. Los motores de una
+// misma resolución (p. ej. las tareas de IDA* paralelo) comparten uno y
+// le cargan los nodos por bloques, así que el presupuesto puede excederse
+// en menos de un bloque por motor.
+// ------------------------------------------------------
+class SearchBudget {
+public:
+    // El reloj del tiempo máximo empieza aquí
+    explicit SearchBudget(const SearchLimits &limits);
+
+    // Suma nodos generados y comprueba los límites; false si hay que parar
+    bool charge(uint64_t count);
+
+    bool stopped() const {
+        return reason() != SolveStatus::Solved;
+    }
+
+    // Motivo de la parada (Solved mientras no se ha detenido)
+    SolveStatus reason() const {
+        return stopReason.load(std::memory_order_relaxed);
+    }
+
+private:
+    SearchLimits limits;
+    std::chrono::steady_clock::time_point deadline;
+    std::atomic<uint64_t> nodes{0};
+    std::atomic<SolveStatus> stopReason{SolveStatus::Solved};
+
+    bool stop(SolveStatus status);
+};
@@ -0,0 +1,10 @@
+// thread_pool.cpp
+
+#include "thread_pool.h"
+
+using namespace std;
+
+WorkStealingPool& sharedPool() {
+    static WorkStealingPool pool((int)max(1u, thread::hardware_concurrency()));
+    return pool;
+}
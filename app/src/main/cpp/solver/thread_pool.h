@@ -0,0 +1,133 @@
+// thread_pool.h
+// Pool de hilos con robo de trabajo y contador de tareas por lote.
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ------------------------------------------------------
+// Pool de hilos con robo de trabajo
+// Cada hilo tiene su propia cola: toma tareas del frente (en orden de
+// envío) y, cuando se vacía, roba del final de la cola de otro hilo.
+// ------------------------------------------------------
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(int threadCount) : queues(std::max(1, threadCount)) {
+        for (size_t i = 0; i < queues.size(); i++){
+            workers.emplace_back([this, i] { workerLoop((int)i); });
+        }
+    }
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        wakeUp.notify_all();
+        for (auto &worker : workers){
+            worker.join();
+        }
+    }
+
+    int threadCount() const {
+        return (int)queues.size();
+    }
+
+    // Encola una tarea en la cola del hilo worker (módulo el número de hilos)
+    void submit(int worker, std::function<void()> task) {
+        WorkerQueue &queue = queues[(size_t)worker % queues.size()];
+        {
+            std::lock_guard<std::mutex> lock(queue.lock);
+            queue.tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            pending++;
+        }
+        wakeUp.notify_one();
+    }
+
+private:
+    struct WorkerQueue {
+        std::mutex lock;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<WorkerQueue> queues;
+    std::vector<std::thread> workers;
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    size_t pending = 0; // tareas encoladas aún no tomadas
+    bool stopping = false;
+
+    bool takeTask(int self, std::function<void()> &task) {
+        {
+            WorkerQueue &own = queues[self];
+            std::lock_guard<std::mutex> lock(own.lock);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.front());
+                own.tasks.pop_front();
+                return true;
+            }
+        }
+        for (size_t offset = 1; offset < queues.size(); offset++){
+            WorkerQueue &victim = queues[(self + offset) % queues.size()];
+            std::lock_guard<std::mutex> lock(victim.lock);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.back());
+                victim.tasks.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void workerLoop(int self) {
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(sleepMutex);
+                wakeUp.wait(lock, [this] { return stopping || pending > 0; });
+                if (stopping && pending == 0)
+                    return;
+            }
+            std::function<void()> task;
+            if (takeTask(self, task)) {
+                {
+                    std::lock_guard<std::mutex> lock(sleepMutex);
+                    pending--;
+                }
+                task();
+            }
+        }
+    }
+};
+
+// Contador de tareas de un lote: wait() bloquea hasta que todas terminan
+class TaskGroup {
+public:
+    explicit TaskGroup(size_t count) : remaining(count) {}
+
+    void done() {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (--remaining == 0)
+            finished.notify_all();
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mtx);
+        finished.wait(lock, [this] { return remaining == 0; });
+    }
+
+private:
+    std::mutex mtx;
+    std::condition_variable finished;
+    size_t remaining;
+};
+
+// Pool compartido del proceso, con un hilo por núcleo
+WorkStealingPool& sharedPool();
@@ -0,0 +1,59 @@
+// transposition_table.cpp
+
+#include "transposition_table.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+using namespace std;
+
+TranspositionTable::TranspositionTable(size_t entries) {
+    size_t count = 1;
+    while (count * 2 * BUCKET_SIZE <= entries) {
+        count *= 2;
+    }
+    // Una cubeta de más para alinear a 64 bytes; sin memoria, una tabla menor
+    while ((memory = calloc(count + 1, sizeof(Bucket))) == nullptr && count > 1) {
+        count /= 2;
+    }
+    buckets = (Bucket*)(((uintptr_t)memory + alignof(Bucket) - 1) & ~(uintptr_t)(alignof(Bucket) - 1));
+    mask = count - 1;
+}
+
+TranspositionTable::~TranspositionTable() {
+    free(memory);
+}
+
+// Entrada del estado si ya está; si no, la víctima según la política de reemplazo
+TranspositionTable::Entry& TranspositionTable::slotFor(uint64_t key, uint64_t hash) {
+    Bucket &bucket = buckets[hash & mask];
+    Entry* victim = &bucket.entries[0];
+    for (Entry &entry : bucket.entries){
+        if (entry.key == key)
+            return entry;
+        if (entry.key == 0) {
+            victim = &entry;
+            break;
+        }
+        bool stale = entry.iteration != iteration, victimStale = victim->iteration != iteration;
+        if (stale != victimStale ? stale : entry.g > victim->g)
+            victim = &entry;
+    }
+    victim->key = key;
+    victim->g = UINT16_MAX;
+    victim->h = 0;
+    victim->iteration = 0;
+    return *victim;
+}
+
+void TranspositionTable::recordVisit(uint64_t key, uint64_t hash, int g) {
+    Entry &entry = slotFor(key, hash);
+    if (entry.iteration != iteration || g < entry.g)
+        entry.g = (uint16_t)g;
+    entry.iteration = iteration;
+}
+
+void TranspositionTable::learn(uint64_t key, uint64_t hash, int h) {
+    Entry &entry = slotFor(key, hash);
+    entry.h = (uint16_t)max<int>(entry.h, min(h, (int)UINT16_MAX));
+}
@@ -0,0 +1,84 @@
+// transposition_table.h
+// Tabla de transposiciones de memoria fija para IDA*: detecta estados
+// repetidos dentro de una iteración y recuerda la h aprendida de cada
+// subárbol que no encontró solución.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// ------------------------------------------------------
+// Cubetas de 4 entradas (una línea de caché) indexadas por el hash del
+// estado; la clave es el uint64_t completo de PackedState, así que no hay
+// falsos positivos (0 no es un estado válido y marca la entrada vacía). Por
+// entrada:
+//   g:    menor g con que se expandió el estado en la iteración iteration.
+//         Volver a llegar con g mayor o igual no puede encontrar nada nuevo.
+//   h:    cota inferior aprendida (válida en todas las iteraciones).
+// Reemplazo: primero entradas de iteraciones anteriores y, entre iguales,
+// la de mayor g (su subárbol es el más barato de repetir).
+// ------------------------------------------------------
+class TranspositionTable {
+public:
+    struct Entry {
+        uint64_t key;
+        uint16_t g;
+        uint16_t h;         // 0: nada aprendido
+        uint32_t iteration; // 0: sin visitas registradas
+    };
+
+    // Entradas aproximadas (se redondea hacia abajo a cubetas potencia de 2)
+    explicit TranspositionTable(size_t entries);
+    ~TranspositionTable();
+
+    TranspositionTable(const TranspositionTable&) = delete;
+    TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+    static size_t entriesForMegabytes(size_t megabytes) {
+        return megabytes * 1024 * 1024 / sizeof(Entry);
+    }
+
+    size_t capacity() const {
+        return (mask + 1) * BUCKET_SIZE;
+    }
+
+    // Empieza una iteración: las g registradas antes dejan de contar
+    uint32_t beginIteration() {
+        return ++iteration;
+    }
+
+    // Entrada del estado o nullptr
+    const Entry* find(uint64_t key, uint64_t hash) const {
+        const Bucket &bucket = buckets[hash & mask];
+        for (const Entry &entry : bucket.entries){
+            if (entry.key == key)
+                return &entry;
+        }
+        return nullptr;
+    }
+
+    // Estado ya expandido en esta iteración con g menor o igual
+    bool isDuplicate(const Entry* entry, int g) const {
+        return entry != nullptr && entry->iteration == iteration && entry->g <= g;
+    }
+
+    // Registra la expansión del estado con g en la iteración actual
+    void recordVisit(uint64_t key, uint64_t hash, int g);
+
+    // Sube la h aprendida del estado (nunca la baja)
+    void learn(uint64_t key, uint64_t hash, int h);
+
+private:
+    static const int BUCKET_SIZE = 4;
+
+    struct alignas(64) Bucket {
+        Entry entries[BUCKET_SIZE];
+    };
+
+    void* memory;       // calloc: las páginas se ponen a cero al tocarlas
+    Bucket* buckets;
+    uint64_t mask;
+    uint32_t iteration = 0;
+
+    Entry& slotFor(uint64_t key, uint64_t hash);
+};
@@ -0,0 +1,85 @@
+// walking_distance.cpp
+
+#include "walking_distance.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+using namespace std;
+
+// 3 bits por recuento (hasta 7 fichas por línea)
+uint64_t WalkingDistanceTable::encode(const int* counts) const {
+    uint64_t key = 0;
+    for (int i = 0; i < side * side; i++){
+        key |= (uint64_t)counts[i] << (3 * i);
+    }
+    return key;
+}
+
+int WalkingDistanceTable::indexOf(const int* counts) const {
+    auto it = indices.find(encode(counts));
+    return it != indices.end() ? it->second : -1;
+}
+
+// BFS desde el objetivo: cada línea tiene sus side fichas, salvo la última
+// que tiene side - 1 y el hueco
+WalkingDistanceTable::WalkingDistanceTable(int side) : side(side) {
+    int cells = side * side;
+    vector<int> counts(cells, 0);
+    for (int line = 0; line < side; line++){
+        counts[line * side + line] = line == side - 1 ? side - 1 : side;
+    }
+    vector<uint64_t> keys(1, encode(counts.data()));
+    indices[keys[0]] = 0;
+    distance.push_back(0);
+    for (size_t index = 0; index < keys.size(); index++){
+        for (int i = 0; i < cells; i++){
+            counts[i] = (int)((keys[index] >> (3 * i)) & 7);
+        }
+        int blankLine = 0;
+        for (int line = 0; line < side; line++){
+            int sum = 0;
+            for (int goal = 0; goal < side; goal++){
+                sum += counts[line * side + goal];
+            }
+            if (sum == side - 1)
+                blankLine = line;
+        }
+        for (int backward = 0; backward < 2; backward++){
+            int from = backward ? blankLine - 1 : blankLine + 1;
+            for (int goal = 0; goal < side; goal++){
+                int next = -1;
+                if (from >= 0 && from < side && counts[from * side + goal] > 0) {
+                    counts[from * side + goal]--;
+                    counts[blankLine * side + goal]++;
+                    uint64_t key = encode(counts.data());
+                    auto it = indices.find(key);
+                    if (it == indices.end()) {
+                        next = (int)keys.size();
+                        indices[key] = next;
+                        keys.push_back(key);
+                        distance.push_back((uint8_t)(distance[index] + 1));
+                    } else {
+                        next = it->second;
+                    }
+                    counts[from * side + goal]++;
+                    counts[blankLine * side + goal]--;
+                }
+                transitions.push_back(next);
+            }
+        }
+    }
+}
+
+const WalkingDistanceTable* WalkingDistanceTable::forSide(int side) {
+    if (side < 2 || side > MAX_SIDE)
+        return nullptr;
+    static mutex tablesMutex;
+    static map<int, unique_ptr<WalkingDistanceTable>> tables;
+    lock_guard<mutex> lock(tablesMutex);
+    unique_ptr<WalkingDistanceTable> &table = tables[side];
+    if (!table)
+        table.reset(new WalkingDistanceTable(side));
+    return table.get();
+}
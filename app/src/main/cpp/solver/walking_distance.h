@@ -0,0 +1,47 @@
+// walking_distance.h
+// Walking distance: tablas de distancias por BFS sobre los recuentos de
+// fichas por línea, con transiciones O(1) por movimiento.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// ------------------------------------------------------
+// El estado vertical es la matriz counts[fila][filaObjetivo] con cuántas
+// fichas de cada fila objetivo hay en cada fila (el hueco no cuenta; su fila
+// es la que suma side - 1). Un movimiento vertical del hueco lleva una ficha
+// de la fila vecina a la del hueco, así que la distancia BFS desde el
+// objetivo es una cota inferior de los movimientos verticales. El estado
+// horizontal es el mismo con columnas, y como el objetivo es simétrico usa
+// la misma tabla. La heurística es la suma de ambas distancias.
+// ------------------------------------------------------
+class WalkingDistanceTable {
+public:
+    // Los estados crecen muy rápido con el tamaño: solo hasta 4x4
+    static const int MAX_SIDE = 4;
+
+    int side;
+    std::vector<uint8_t> distance;       // por índice de estado
+    std::vector<int32_t> transitions;    // [estado][sentido del hueco][línea objetivo], -1 si no hay
+
+    // Tabla compartida del proceso, o nullptr si side no está soportado
+    static const WalkingDistanceTable* forSide(int side);
+
+    // Índice del estado con los recuentos counts[línea * side + líneaObjetivo]
+    int indexOf(const int* counts) const;
+
+    // Estado tras mover el hueco a la línea siguiente (backward = 0) o a la
+    // anterior (backward = 1), trayendo una ficha cuya línea objetivo es
+    // goalLine. Coincide con dirIndex & 1 de Puzzle::DIRECTIONS.
+    int next(int index, int backward, int goalLine) const {
+        return transitions[((size_t)index * 2 + (size_t)backward) * (size_t)side + (size_t)goalLine];
+    }
+
+private:
+    std::unordered_map<uint64_t, int> indices;
+
+    explicit WalkingDistanceTable(int side);
+    uint64_t encode(const int* counts) const;
+};
@@ -0,0 +1,95 @@
+// anytime_test.cpp
+// Resolución anytime: sin límites termina con la óptima; con límites da la
+// mejor encontrada con un factor que acota su longitud real.
+
+#include "test_util.h"
+
+#include "solver/anytime.h"
+#include "solver/ida_star.h"
+#include "solver/patterndb_c.h"
+
+#include <chrono>
+#include <cstdio>
+
+using namespace std;
+
+TEST(anytime, unlimited_is_optimal) {
+    for (uint32_t seed = 1; seed <= 3; seed++){
+        Puzzle hard = scrambledPuzzle(4, 4, 80, seed);
+        int optimal = (int)iterativeIDAStar(hard, smallPatternDB()).size();
+        SearchStats stats;
+        Moves moves = anytimeSolve(hard, &smallPatternDB(), SearchOptions(), &stats);
+        CHECK(stats.status == SolveStatus::Solved);
+        CHECK(replayToGoal(hard, moves));
+        CHECK_EQ((int)moves.size(), optimal);
+        CHECK(stats.suboptimality == 1.0);
+    }
+    // Sin PatternDB, con el solver genérico
+    Puzzle puzzle = scrambledPuzzle(3, 4, 14, 4);
+    SearchStats stats;
+    Moves moves = anytimeSolve(puzzle, nullptr, SearchOptions(), &stats);
+    CHECK(replayToGoal(puzzle, moves));
+    CHECK_EQ((int)moves.size(), bfsDistance(puzzle, 14));
+}
+
+// Con un presupuesto corto: o la mejor solución hasta entonces (con su
+// factor probado) o el motivo de la parada si aún no había ninguna
+TEST(anytime, limited_returns_best_so_far) {
+    Puzzle hard = scrambledPuzzle(4, 4, 80, 3);
+    int optimal = (int)iterativeIDAStar(hard, smallPatternDB()).size();
+    int solved = 0;
+    for (uint64_t maxNodes : {(uint64_t)2000, (uint64_t)50000, (uint64_t)300000}){
+        SearchOptions options;
+        options.limits.maxNodes = maxNodes;
+        SearchStats stats;
+        Moves moves = anytimeSolve(hard, &smallPatternDB(), options, &stats);
+        CHECK(stats.bound <= optimal);
+        if (stats.status != SolveStatus::Solved) {
+            CHECK(stats.status == SolveStatus::BudgetExhausted);
+            CHECK(moves.empty());
+            continue;
+        }
+        solved++;
+        CHECK(replayToGoal(hard, moves));
+        CHECK(stats.suboptimality >= 1.0);
+        CHECK((int)moves.size() <= stats.suboptimality * optimal + 1e-9);
+        if (stats.bound > 0)
+            CHECK(stats.suboptimality <= (double)moves.size() / stats.bound + 1e-9);
+    }
+    CHECK(solved > 0);
+
+    auto linear = builtinPatternDB(4, false);
+    SearchOptions options;
+    options.limits.timeoutMicros = 2000;
+    SearchStats stats;
+    auto start = chrono::steady_clock::now();
+    Moves moves = anytimeSolve(hard, linear.get(), options, &stats);
+    CHECK(chrono::steady_clock::now() - start < chrono::seconds(1));
+    CHECK(stats.status == SolveStatus::Solved || stats.status == SolveStatus::Timeout);
+    if (stats.status == SolveStatus::Solved)
+        CHECK(replayToGoal(hard, moves));
+}
+
+TEST(anytime, c_api_anytime) {
+    const char* path = "test_anytime.pdb";
+    writePatternDBBinary(smallPatternDB(), path);
+    pdb_database* db = pdb_load(path, 4);
+    Puzzle hard = scrambledPuzzle(4, 4, 80, 1);
+    vector<int> tiles = boardTiles(hard);
+    pdb_options options;
+    pdb_options_init(&options);
+    options.anytime = 1;
+    pdb_solve_result result;
+    CHECK(pdb_solve(db, tiles.data(), 4, &options, &result) == PDB_STATUS_SOLVED);
+    CHECK(replayToGoal(hard, movesFromLetters(result.moves)));
+    CHECK_EQ(result.length, (int)iterativeIDAStar(hard, smallPatternDB()).size());
+    CHECK(result.suboptimality == 1.0);
+
+    Puzzle grid = scrambledPuzzle(4, 3, 14, 2);
+    tiles = boardTiles(grid);
+    CHECK(pdb_solve_grid(tiles.data(), 4, 3, &options, &result) == PDB_STATUS_SOLVED);
+    CHECK(replayToGoal(grid, movesFromLetters(result.moves)));
+    CHECK_EQ(result.length, bfsDistance(grid, 14));
+    pdb_release(db);
+    remove(path);
+}
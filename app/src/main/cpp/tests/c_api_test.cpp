@@ -0,0 +1,151 @@
+// c_api_test.cpp
+// API C: resultados de los modos de resolución y compatibilidad de pdb_options.
+
+#include "test_util.h"
+
+#include "solver/ida_star.h"
+#include "solver/patterndb_c.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+
+using namespace std;
+
+// PatternDB pequeña escrita en disco y cargada con pdb_load
+class LoadedDatabase {
+public:
+    LoadedDatabase() {
+        writePatternDBBinary(smallPatternDB(), path);
+        db = pdb_load(path, 4);
+    }
+
+    ~LoadedDatabase() {
+        pdb_release(db);
+        remove(path);
+    }
+
+    pdb_database* db = nullptr;
+
+private:
+    const char* path = "test_c_api.pdb";
+};
+
+static void checkSolved(const pdb_solve_result &result, const ReferenceBoard &board) {
+    CHECK(result.status == PDB_STATUS_SOLVED);
+    CHECK_EQ(result.length, board.distance);
+    CHECK_EQ((int)strlen(result.moves), result.length);
+    CHECK(replayToGoal(board.puzzle, movesFromLetters(result.moves)));
+}
+
+TEST(c_api, solve_modes_are_optimal) {
+    LoadedDatabase loaded;
+    CHECK(loaded.db != nullptr);
+    pdb_options options;
+    pdb_options_init(&options);
+    vector<int> all;
+    for (const auto &board : referenceBoards()){
+        vector<int> tiles = boardTiles(board.puzzle);
+        all.insert(all.end(), tiles.begin(), tiles.end());
+        pdb_solve_result result;
+        options.parallel = 0;
+        pdb_solve(loaded.db, tiles.data(), 4, &options, &result);
+        checkSolved(result, board);
+        options.parallel = 1;
+        pdb_solve(loaded.db, tiles.data(), 4, &options, &result);
+        checkSolved(result, board);
+    }
+    int count = (int)referenceBoards().size();
+    vector<pdb_solve_result> results(count);
+    options.parallel = 0;
+    pdb_solve_batch(loaded.db, all.data(), count, 4, &options, results.data());
+    for (int i = 0; i < count; i++){
+        checkSolved(results[i], referenceBoards()[i]);
+    }
+}
+
+// Un llamador compilado con una pdb_options más corta sigue funcionando y
+// los campos que no conoce valen lo de pdb_options_init
+TEST(c_api, options_struct_size) {
+    LoadedDatabase loaded;
+    const ReferenceBoard &board = referenceBoards().back();
+    vector<int> tiles = boardTiles(board.puzzle);
+    pdb_solve_result result;
+
+    pdb_options options;
+    pdb_options_init(&options);
+    CHECK_EQ(options.struct_size, (uint32_t)sizeof(pdb_options));
+
+    // Cabecera antigua: termina antes de transposition_mb; la basura que
+    // sigue en la memoria del llamador no se lee
+    pdb_options old;
+    memset(&old, 0x7F, sizeof(old));
+    pdb_options_init(&old);
+    old.struct_size = (uint32_t)offsetof(pdb_options, transposition_mb);
+    memset((char*)&old + old.struct_size, 0x7F, sizeof(old) - old.struct_size);
+    CHECK(pdb_solve(loaded.db, tiles.data(), 4, &old, &result) == PDB_STATUS_SOLVED);
+    checkSolved(result, board);
+    CHECK(result.suboptimality == 1.0);
+
+    CHECK(pdb_solve(loaded.db, tiles.data(), 4, nullptr, &result) == PDB_STATUS_SOLVED);
+    checkSolved(result, board);
+
+    pdb_options uninitialized;
+    memset(&uninitialized, 0, sizeof(uninitialized));
+    CHECK(pdb_solve(loaded.db, tiles.data(), 4, &uninitialized, &result) == PDB_STATUS_INVALID_INPUT);
+}
+
+TEST(c_api, result_is_cleared) {
+    LoadedDatabase loaded;
+    vector<int> tiles = boardTiles(referenceBoards()[1].puzzle);
+    pdb_solve_result result;
+    memset(&result, 0x55, sizeof(result));
+    pdb_solve(loaded.db, tiles.data(), 4, nullptr, &result);
+    for (int64_t reserved : result.reserved){
+        CHECK_EQ(reserved, (int64_t)0);
+    }
+    memset(&result, 0x55, sizeof(result));
+    tiles[0] = tiles[1];
+    CHECK(pdb_solve(loaded.db, tiles.data(), 4, nullptr, &result) == PDB_STATUS_INVALID_INPUT);
+    CHECK_EQ(result.length, 0);
+    CHECK_EQ((int)result.moves[0], 0);
+    CHECK(pdb_solve(nullptr, boardTiles(Puzzle(4)).data(), 4, nullptr, &result) == PDB_STATUS_NO_DATABASE);
+}
+
+// Los tableros sin solución se rechazan antes de buscar
+TEST(c_api, unsolvable_is_rejected) {
+    LoadedDatabase loaded;
+    Puzzle swapped(4);
+    swap(swapped.board[0][0], swapped.board[0][1]);
+    CHECK(!isSolvable(swapped));
+    vector<int> tiles = boardTiles(swapped);
+    pdb_solve_result result;
+    CHECK(pdb_solve(loaded.db, tiles.data(), 4, nullptr, &result) == PDB_STATUS_UNSOLVABLE);
+    CHECK_EQ(result.nodes, (uint64_t)0);
+    vector<int> both = boardTiles(referenceBoards()[2].puzzle);
+    both.insert(both.end(), tiles.begin(), tiles.end());
+    pdb_solve_result results[2];
+    pdb_solve_batch(loaded.db, both.data(), 2, 4, nullptr, results);
+    checkSolved(results[0], referenceBoards()[2]);
+    CHECK(results[1].status == PDB_STATUS_UNSOLVABLE);
+    Puzzle rectangular(3, 4);
+    swap(rectangular.board[1][0], rectangular.board[1][1]);
+    tiles = boardTiles(rectangular);
+    CHECK(pdb_solve_grid(tiles.data(), 3, 4, nullptr, &result) == PDB_STATUS_UNSOLVABLE);
+}
+
+TEST(c_api, weighted_solve) {
+    LoadedDatabase loaded;
+    Puzzle hard = scrambledPuzzle(4, 4, 80, 1);
+    int optimal = (int)iterativeIDAStar(hard, smallPatternDB()).size();
+    vector<int> tiles = boardTiles(hard);
+    pdb_options options;
+    pdb_options_init(&options);
+    options.weight = 2.0;
+    pdb_solve_result result;
+    CHECK(pdb_solve(loaded.db, tiles.data(), 4, &options, &result) == PDB_STATUS_SOLVED);
+    CHECK(replayToGoal(hard, movesFromLetters(result.moves)));
+    CHECK(result.length <= 2 * optimal);
+    CHECK(result.suboptimality >= 1.0 && result.suboptimality <= 2.0);
+    CHECK(result.length <= result.suboptimality * optimal + 1e-9);
+}
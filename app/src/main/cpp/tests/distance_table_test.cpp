@@ -0,0 +1,83 @@
+// distance_table_test.cpp
+// Tablas de distancias exactas: cada entrada es la distancia del BFS de
+// referencia (mód DISTANCE_MODULUS) y el descenso da caminos óptimos.
+
+#include "test_util.h"
+
+#include "solver/distance_table.h"
+#include "solver/grid_solver.h"
+#include "solver/patterndb_c.h"
+
+#include <algorithm>
+#include <cstdio>
+
+using namespace std;
+
+static void checkTableAgainstBfs(int rows, int cols, int solveStep) {
+    auto table = DistanceTable::build(rows, cols);
+    CHECK(table != nullptr);
+    if (table == nullptr)
+        return;
+    auto distances = bfsFromGoal(rows, cols);
+    CHECK_EQ(table->entries, (uint64_t)distances.size());
+    int index = 0;
+    for (const auto &entry : distances){
+        int positions[DISTANCE_TABLE_MAX_CELLS];
+        for (int cell = 0; cell < rows * cols; cell++){
+            positions[entry.first[cell] - 'A'] = cell;
+        }
+        CHECK_EQ((int)table->valueAt(table->indexOf(positions)), entry.second % DISTANCE_MODULUS);
+        if (index++ % solveStep != 0)
+            continue;
+        Puzzle puzzle = puzzleFromKey(entry.first, rows, cols);
+        Moves moves;
+        CHECK(table->solve(puzzle, moves));
+        CHECK(replayToGoal(puzzle, moves));
+        CHECK_EQ((int)moves.size(), entry.second);
+    }
+}
+
+TEST(distance_table, entries_match_bfs) {
+    checkTableAgainstBfs(2, 2, 1);
+    checkTableAgainstBfs(2, 3, 1);
+    checkTableAgainstBfs(3, 2, 1);
+    checkTableAgainstBfs(2, 4, 7);
+    checkTableAgainstBfs(3, 3, 101);
+}
+
+TEST(distance_table, file_round_trip) {
+    auto table = DistanceTable::build(2, 4);
+    const string path = "test_2x4.dst";
+    CHECK(writeDistanceTable(*table, path));
+    auto loaded = parseDistanceTable(mapPdbFile(path), 2, 4, true);
+    CHECK(loaded != nullptr);
+    if (loaded != nullptr) {
+        CHECK_EQ(loaded->byteSize(), table->byteSize());
+        CHECK(equal(table->data(), table->data() + table->byteSize(), loaded->data()));
+    }
+    CHECK(parseDistanceTable(mapPdbFile(path), 4, 2, true) == nullptr);
+    remove(path.c_str());
+}
+
+// Solo preloadDistanceTable genera tablas; con la tabla, solveGrid no busca
+TEST(distance_table, grid_solves_use_preloaded_table) {
+    CHECK(distanceTableFor(2, 5) == nullptr);
+    CHECK(!preloadDistanceTable(3, 4));
+    CHECK(pdb_preload_distance_table(2, 5) == 1);
+    CHECK(distanceTableFor(2, 5) != nullptr);
+    for (uint32_t seed = 1; seed <= 5; seed++){
+        Puzzle puzzle = scrambledPuzzle(2, 5, 14, seed);
+        SearchStats stats;
+        Moves moves = solveGrid(puzzle, SearchOptions(), &stats);
+        CHECK(stats.status == SolveStatus::Solved);
+        CHECK_EQ(stats.nodes, (uint64_t)0);
+        CHECK(replayToGoal(puzzle, moves));
+        CHECK_EQ((int)moves.size(), bfsDistance(puzzle, 14));
+
+        vector<int> tiles = boardTiles(puzzle);
+        pdb_solve_result result;
+        CHECK(pdb_solve_grid(tiles.data(), 2, 5, nullptr, &result) == PDB_STATUS_SOLVED);
+        CHECK_EQ(result.nodes, (uint64_t)0);
+        CHECK_EQ(result.length, (int)moves.size());
+    }
+}
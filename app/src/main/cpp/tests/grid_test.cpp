@@ -0,0 +1,157 @@
+// grid_test.cpp
+// Solver rows x cols: longitudes óptimas frente al BFS de referencia, en
+// todo el espacio de los tableros pequeños y en paseos de los grandes.
+
+#include "test_util.h"
+
+#include "solver/grid_solver.h"
+#include "solver/ida_star.h"
+#include "solver/patterndb_c.h"
+#include "solver/pdb_generator.h"
+
+#include <cstdio>
+
+using namespace std;
+
+// Uno de cada step tableros alcanzables, resuelto con el motor del tamaño
+template <int R, int C>
+static void checkEngineAgainstBfs(int step) {
+    auto distances = bfsFromGoal(R, C);
+    int index = 0;
+    for (const auto &entry : distances){
+        if (index++ % step != 0)
+            continue;
+        Puzzle puzzle = puzzleFromKey(entry.first, R, C);
+        GridEngine<R, C> engine(puzzle);
+        CHECK(engine.solve() == SolveStatus::Solved);
+        Moves moves = engine.path().toDirections();
+        CHECK(replayToGoal(puzzle, moves));
+        CHECK_EQ((int)moves.size(), entry.second);
+    }
+}
+
+TEST(grid, small_boards_match_bfs) {
+    checkEngineAgainstBfs<2, 2>(1);
+    checkEngineAgainstBfs<2, 3>(1);
+    checkEngineAgainstBfs<3, 2>(1);
+    checkEngineAgainstBfs<2, 4>(20);
+    checkEngineAgainstBfs<4, 2>(20);
+    checkEngineAgainstBfs<3, 3>(1000);
+}
+
+// Paseos cortos en el resto de las formas (también rectangulares)
+TEST(grid, larger_boards_match_bfs) {
+    const int shapes[][2] = { {3, 4}, {4, 3}, {2, 6}, {6, 2}, {4, 4}, {3, 5}, {4, 5}, {5, 4}, {5, 5}, {6, 6} };
+    uint32_t seed = 1;
+    for (const auto &shape : shapes){
+        int rows = shape[0], cols = shape[1];
+        int steps = rows * cols <= 20 ? 14 : 10;
+        for (int i = 0; i < 3; i++, seed++){
+            Puzzle puzzle = scrambledPuzzle(rows, cols, steps, seed);
+            SearchStats stats;
+            Moves moves = solveGrid(puzzle, SearchOptions(), &stats);
+            CHECK(stats.status == SolveStatus::Solved);
+            CHECK(replayToGoal(puzzle, moves));
+            CHECK_EQ((int)moves.size(), bfsDistance(puzzle, steps));
+            CHECK_EQ(stats.bound, (int)moves.size());
+        }
+    }
+}
+
+// En 4x4 coincide con el motor de PackedState
+TEST(grid, square_matches_packed_engine) {
+    for (const auto &board : referenceBoards()){
+        Moves moves = solveGrid(board.puzzle);
+        CHECK(replayToGoal(board.puzzle, moves));
+        CHECK_EQ((int)moves.size(), board.distance);
+    }
+    Puzzle hard = scrambledPuzzle(4, 4, 80, 2);
+    CHECK_EQ(solveGrid(hard).size(), iterativeIDAStar(hard, smallPatternDB()).size());
+}
+
+TEST(grid, rejected_boards) {
+    SearchStats stats;
+    Puzzle duplicated(3, 4);
+    duplicated.board[0][0] = 2;
+    solveGrid(duplicated, SearchOptions(), &stats);
+    CHECK(stats.status == SolveStatus::InvalidInput);
+    Puzzle swapped(2, 5);
+    swap(swapped.board[0][0], swapped.board[0][1]);
+    CHECK(solveGrid(swapped, SearchOptions(), &stats).empty());
+    CHECK(stats.status == SolveStatus::Unsolvable);
+    solveGrid(Puzzle(7, 3), SearchOptions(), &stats);
+    CHECK(stats.status == SolveStatus::InvalidInput);
+}
+
+// ------------------------------------------------------
+// 5x5 con PatternDB aditiva (ocho grupos de 3 fichas)
+// ------------------------------------------------------
+static const PatternDatabase& smallPatternDB5() {
+    static shared_ptr<PatternDatabase> db = generatePatternDB(
+            {{1, 2, 3}, {4, 5, 10}, {6, 7, 8}, {9, 14, 15}, {11, 12, 13}, {16, 17, 18}, {19, 20, 24}, {21, 22, 23}}, 5);
+    return *db;
+}
+
+TEST(grid, pattern_db_5x5_is_optimal) {
+    const PatternDatabase &db = smallPatternDB5();
+    CHECK_EQ(db.boardSize, 5);
+    for (uint32_t seed = 1; seed <= 4; seed++){
+        Puzzle puzzle = scrambledPuzzle(5, 5, 10, seed);
+        int distance = bfsDistance(puzzle, 10);
+        for (bool reflect : {false, true}){
+            SearchOptions options;
+            options.reflect = reflect;
+            CHECK((GridEngine<5, 5>(puzzle, &db, options).heuristicValue() <= distance));
+            SearchStats stats;
+            Moves moves = solveGrid(puzzle, &db, options, &stats);
+            CHECK(stats.status == SolveStatus::Solved);
+            CHECK(replayToGoal(puzzle, moves));
+            CHECK_EQ((int)moves.size(), distance);
+        }
+    }
+    // Más profundo: la misma longitud que sin PatternDB
+    Puzzle deep = scrambledPuzzle(5, 5, 40, 9);
+    SearchStats withTables, without;
+    Moves moves = solveGrid(deep, &db, SearchOptions(), &withTables);
+    CHECK(replayToGoal(deep, moves));
+    CHECK_EQ(moves.size(), solveGrid(deep, nullptr, SearchOptions(), &without).size());
+}
+
+TEST(grid, pattern_db_5x5_through_c_api) {
+    const char* path = "test_5x5.pdb";
+    CHECK(writePatternDBBinary(smallPatternDB5(), path));
+    pdb_database* db = pdb_load(path, 5);
+    CHECK(db != nullptr);
+    Puzzle puzzle = scrambledPuzzle(5, 5, 10, 3);
+    vector<int> tiles = boardTiles(puzzle);
+    pdb_solve_result result;
+    CHECK(pdb_solve(db, tiles.data(), 5, nullptr, &result) == PDB_STATUS_SOLVED);
+    CHECK(replayToGoal(puzzle, movesFromLetters(result.moves)));
+    CHECK_EQ(result.length, bfsDistance(puzzle, 10));
+    CHECK(pdb_solve(db, boardTiles(Puzzle(4)).data(), 4, nullptr, &result) == PDB_STATUS_NO_DATABASE);
+    pdb_release(db);
+    remove(path);
+}
+
+TEST(grid, weighted_solves_are_bounded) {
+    const int shapes[][2] = { {3, 4}, {4, 4}, {5, 5} };
+    for (const auto &shape : shapes){
+        Puzzle puzzle = scrambledPuzzle(shape[0], shape[1], 12, 5);
+        int optimal = bfsDistance(puzzle, 12);
+        for (double weight : {1.5, 3.0}){
+            SearchOptions options;
+            options.weight = weight;
+            SearchStats stats;
+            Moves moves = solveGrid(puzzle, options, &stats);
+            CHECK(stats.status == SolveStatus::Solved);
+            CHECK(replayToGoal(puzzle, moves));
+            CHECK((int)moves.size() <= weight * optimal);
+            CHECK((int)moves.size() <= stats.suboptimality * optimal + 1e-9);
+        }
+        SearchOptions limited;
+        limited.costLimit = optimal;
+        SearchStats stats;
+        CHECK(solveGrid(puzzle, limited, &stats).empty());
+        CHECK(stats.status == SolveStatus::NoSolution);
+    }
+}
@@ -0,0 +1,60 @@
+// heuristic_test.cpp
+// Heurísticas sin tablas (conflictos lineales y walking distance): son
+// admisibles y las resoluciones con ellas siguen siendo óptimas.
+
+#include "test_util.h"
+
+#include "solver/heuristic.h"
+#include "solver/ida_star.h"
+
+using namespace std;
+
+TEST(heuristic, builtin_are_admissible) {
+    auto linear = builtinPatternDB(4, false);
+    auto walking = builtinPatternDB(4, true);
+    CHECK(walking->walkingDistance);
+    for (const auto &board : referenceBoards()){
+        PackedState state = PackedState::fromPuzzle(board.puzzle);
+        int manhattanOnly = manhattan(state, ~0u);
+        int withConflicts = hScore(state, *linear);
+        CHECK(manhattanOnly <= withConflicts);
+        CHECK(withConflicts <= board.distance);
+        CHECK(withConflicts <= hScore(state, *walking));
+        CHECK(hScore(state, *walking) <= board.distance);
+    }
+    // Un conflicto lineal (2 1 en su fila) cuesta dos movimientos más
+    Puzzle swapped(4);
+    string error;
+    parsePuzzle("2 1 3 4;5 6 7 8;9 10 11 12;13 14 15 0", swapped, error);
+    CHECK_EQ(hScore(PackedState::fromPuzzle(swapped), *linear), 4);
+}
+
+TEST(heuristic, builtin_incremental_matches_full) {
+    for (bool walkingDistance : {false, true}){
+        auto db = builtinPatternDB(4, walkingDistance);
+        PackedState state = PackedState::fromPuzzle(Puzzle(4));
+        IncrementalHeuristic heuristic(*db);
+        heuristic.reset(state);
+        for (int step = 0; step < 400; step++){
+            int dir = (step * 11 + step / 3) % 4;
+            if (!state.canMove(dir))
+                continue;
+            int target = state.blank + PackedState::OFFSETS[dir];
+            HeuristicUndo undo;
+            heuristic.moveTile(state.tileAt(target), target, state.blank, undo);
+            state.applyMove(dir);
+            CHECK_EQ(heuristic.value(), hScore(state, *db));
+        }
+    }
+}
+
+TEST(heuristic, builtin_solves_are_optimal) {
+    for (bool walkingDistance : {false, true}){
+        auto db = builtinPatternDB(4, walkingDistance);
+        for (const auto &board : referenceBoards()){
+            Moves moves = iterativeIDAStar(board.puzzle, *db);
+            CHECK(replayToGoal(board.puzzle, moves));
+            CHECK_EQ((int)moves.size(), board.distance);
+        }
+    }
+}
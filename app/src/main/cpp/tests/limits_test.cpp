@@ -0,0 +1,150 @@
+// limits_test.cpp
+// Cancelación, tiempo máximo y presupuesto de nodos: las búsquedas se
+// detienen con el motivo correcto y estadísticas parciales coherentes.
+
+#include "test_util.h"
+
+#include "solver/batch.h"
+#include "solver/ida_star.h"
+#include "solver/patterndb_c.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace std;
+
+// 44 movimientos: más de un millón de nodos con la PatternDB pequeña
+static Puzzle hardPuzzle() {
+    return scrambledPuzzle(4, 4, 80, 3);
+}
+
+static int64_t elapsedMillis(chrono::steady_clock::time_point start) {
+    return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+}
+
+TEST(limits, node_budget) {
+    SearchOptions options;
+    options.limits.maxNodes = 10000;
+    SearchStats stats;
+    Moves moves = iterativeIDAStar(hardPuzzle(), smallPatternDB(), options, &stats);
+    CHECK(stats.status == SolveStatus::BudgetExhausted);
+    CHECK(moves.empty());
+    CHECK(stats.nodes >= options.limits.maxNodes);
+    CHECK(stats.nodes < options.limits.maxNodes + 2 * IDAStarEngine::STOP_CHECK_INTERVAL);
+    CHECK(stats.bound > 0 && stats.bound <= 44);
+
+    moves = parallelIDAStar(hardPuzzle(), smallPatternDB(), sharedPool(), options, &stats);
+    CHECK(stats.status == SolveStatus::BudgetExhausted);
+    CHECK(moves.empty());
+}
+
+TEST(limits, timeout) {
+    SearchOptions options;
+    options.limits.timeoutMicros = 2000;
+    auto db = builtinPatternDB(4, false);
+    SearchStats stats;
+    auto start = chrono::steady_clock::now();
+    Moves moves = iterativeIDAStar(hardPuzzle(), *db, options, &stats);
+    CHECK(stats.status == SolveStatus::Timeout);
+    CHECK(moves.empty());
+    CHECK(elapsedMillis(start) < 1000);
+}
+
+TEST(limits, cancellation) {
+    auto db = builtinPatternDB(4, false);
+    CancellationToken cancelled;
+    cancelled.cancel();
+    SearchOptions options;
+    options.limits.cancel = &cancelled;
+    SearchStats stats;
+    iterativeIDAStar(hardPuzzle(), *db, options, &stats);
+    CHECK(stats.status == SolveStatus::Cancelled);
+    parallelIDAStar(hardPuzzle(), *db, sharedPool(), options, &stats);
+    CHECK(stats.status == SolveStatus::Cancelled);
+
+    // Cancelación desde otro hilo durante la búsqueda
+    CancellationToken token;
+    options.limits.cancel = &token;
+    thread canceller([&token] {
+        this_thread::sleep_for(chrono::milliseconds(5));
+        token.cancel();
+    });
+    auto start = chrono::steady_clock::now();
+    Moves moves = iterativeIDAStar(hardPuzzle(), *db, options, &stats);
+    canceller.join();
+    CHECK(stats.status == SolveStatus::Cancelled);
+    CHECK(moves.empty());
+    CHECK(elapsedMillis(start) < 1000);
+}
+
+// En un lote el presupuesto es por tablero y el token, común
+TEST(limits, batch_limits) {
+    vector<Puzzle> puzzles = { referenceBoards()[3].puzzle, hardPuzzle(), referenceBoards()[4].puzzle };
+    SearchOptions options;
+    options.limits.maxNodes = 10000;
+    vector<BatchResult> results = solveBatch(puzzles, smallPatternDB(), sharedPool(), options);
+    CHECK(results[0].status == SolveStatus::Solved);
+    CHECK(results[1].status == SolveStatus::BudgetExhausted);
+    CHECK(results[2].status == SolveStatus::Solved);
+    CHECK_EQ((int)results[2].moves.size(), referenceBoards()[4].distance);
+
+    CancellationToken cancelled;
+    cancelled.cancel();
+    options.limits.cancel = &cancelled;
+    results = solveBatch(puzzles, smallPatternDB(), sharedPool(), options);
+    for (const auto &result : results){
+        CHECK(result.status == SolveStatus::Cancelled);
+    }
+}
+
+TEST(limits, c_api_limits) {
+    const char* path = "test_limits.pdb";
+    writePatternDBBinary(smallPatternDB(), path);
+    pdb_database* db = pdb_load(path, 4);
+    vector<int> tiles = boardTiles(hardPuzzle());
+    pdb_options options;
+    pdb_options_init(&options);
+    options.max_nodes = 10000;
+    pdb_solve_result result;
+    CHECK(pdb_solve(db, tiles.data(), 4, &options, &result) == PDB_STATUS_BUDGET_EXHAUSTED);
+    CHECK(result.nodes >= options.max_nodes);
+    CHECK_EQ(result.length, 0);
+
+    options.max_nodes = 0;
+    options.cancel = pdb_cancel_token_create();
+    pdb_cancel(options.cancel);
+    CHECK(pdb_solve(db, tiles.data(), 4, &options, &result) == PDB_STATUS_CANCELLED);
+    pdb_cancel_token_destroy(options.cancel);
+    pdb_release(db);
+    remove(path);
+}
+
+// El progreso llega en el hilo que resuelve, una vez por iteración, con
+// límites crecientes y nodos que no decrecen
+TEST(limits, progress_callbacks) {
+    const Puzzle puzzle = hardPuzzle();
+    for (bool parallel : {false, true}){
+        vector<pair<int, uint64_t>> calls;
+        thread::id caller = this_thread::get_id();
+        bool sameThread = true;
+        SearchOptions options;
+        options.progress = [&](int bound, uint64_t nodes) {
+            calls.push_back({bound, nodes});
+            sameThread = sameThread && this_thread::get_id() == caller;
+        };
+        SearchStats stats;
+        Moves moves = parallel ? parallelIDAStar(puzzle, smallPatternDB(), sharedPool(), options, &stats)
+                               : iterativeIDAStar(puzzle, smallPatternDB(), options, &stats);
+        CHECK(stats.status == SolveStatus::Solved);
+        CHECK(sameThread);
+        CHECK(calls.size() > 1);
+        for (size_t i = 1; i < calls.size(); i++){
+            CHECK(calls[i].first > calls[i - 1].first);
+            CHECK(calls[i].second >= calls[i - 1].second);
+        }
+        if (!calls.empty()) {
+            CHECK(calls.back().first <= (int)moves.size());
+            CHECK(calls.back().second <= stats.nodes);
+        }
+    }
+}
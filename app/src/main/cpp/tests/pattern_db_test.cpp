@@ -0,0 +1,175 @@
+// pattern_db_test.cpp
+// Generación de PatternDBs y formato binario.
+
+#include "test_util.h"
+
+#include "solver/heuristic.h"
+#include "solver/pdb_generator.h"
+
+#include <algorithm>
+#include <cstdio>
+
+using namespace std;
+
+static uint64_t goalRank(const PatternGroup &group) {
+    int positions[PackedState::CELLS];
+    for (size_t i = 0; i < group.tiles.size(); i++){
+        positions[i] = group.tiles[i] - 1;
+    }
+    return rankPattern(positions, (int)group.tiles.size(), PackedState::CELLS);
+}
+
+// Las tablas generadas están completas, valen 0 en el objetivo y nunca
+// menos que el Manhattan de su grupo
+TEST(pattern_db, generated_tables) {
+    const PatternDatabase &db = smallPatternDB();
+    CHECK_EQ(db.groups.size(), (size_t)5);
+    for (const auto &group : db.groups){
+        CHECK(group.complete);
+        CHECK_EQ(group.entries, permutationCount(16, 3));
+        CHECK_EQ((int)group.table[goalRank(group)], 0);
+        int positions[3];
+        for (uint64_t rank = 0; rank < group.entries; rank++){
+            unrankPattern(rank, 3, 16, positions);
+            int distance = 0;
+            for (int i = 0; i < 3; i++){
+                distance += manhattanCost(group.tiles[i], positions[i]);
+            }
+            CHECK(group.table[rank] >= distance);
+            CHECK_EQ((group.table[rank] - distance) & 1, 0);
+        }
+    }
+    CHECK(generatePatternDB({{1, 2}, {2, 3}}, 4) == nullptr);
+    CHECK(generatePatternDB({{0, 1}}, 4) == nullptr);
+}
+
+TEST(pattern_db, binary_round_trip) {
+    const PatternDatabase &db = smallPatternDB();
+    const string path = "test_small.pdb";
+    CHECK(writePatternDBBinary(db, path));
+    auto loaded = loadPatternDB(path, 4);
+    CHECK(loaded != nullptr);
+    if (loaded == nullptr)
+        return;
+    CHECK_EQ(loaded->groups.size(), db.groups.size());
+    for (size_t g = 0; g < db.groups.size() && g < loaded->groups.size(); g++){
+        const auto &expected = db.groups[g];
+        const auto &actual = loaded->groups[g];
+        CHECK(actual.tiles == expected.tiles);
+        CHECK_EQ(actual.entries, expected.entries);
+        CHECK(actual.complete);
+        CHECK(equal(expected.table, expected.table + expected.entries, actual.table));
+    }
+    CHECK(parsePatternDBBinary(mapPdbFile(path), 4, true) != nullptr);
+    CHECK(loadPatternDB(path, 5) == nullptr);
+    remove(path.c_str());
+}
+
+static int placementManhattan(const PatternGroup &group, uint64_t rank, int* positions) {
+    int k = (int)group.tiles.size();
+    unrankPattern(rank, k, PackedState::CELLS, positions);
+    int distance = 0;
+    for (int i = 0; i < k; i++){
+        distance += manhattanCost(group.tiles[i], positions[i]);
+    }
+    return distance;
+}
+
+// Las mismas tablas escritas y cargadas de nuevo
+static shared_ptr<const PatternDatabase> reloaded(const PatternDatabase &db) {
+    const string path = "test_encoded.pdb";
+    CHECK(writePatternDBBinary(db, path));
+    auto loaded = parsePatternDBBinary(mapPdbFile(path), db.boardSize, true);
+    remove(path.c_str());
+    return loaded;
+}
+
+// Nibble: el exceso sobre Manhattan reproduce exactamente los bytes
+TEST(pattern_db, nibble_encoding_round_trip) {
+    const PatternDatabase &db = smallPatternDB();
+    auto encoded = encodePatternDB(db, PDB_ENCODING_NIBBLE);
+    CHECK(encoded != nullptr);
+    if (encoded == nullptr)
+        return;
+    auto loaded = reloaded(*encoded);
+    CHECK(loaded != nullptr);
+    for (const PatternDatabase* candidate : {(const PatternDatabase*)encoded.get(), loaded.get()}){
+        if (candidate == nullptr)
+            continue;
+        for (size_t g = 0; g < db.groups.size(); g++){
+            const auto &group = candidate->groups[g];
+            CHECK_EQ(group.entryBits, PDB_ENCODING_NIBBLE);
+            CHECK(group.complete);
+            CHECK_EQ(patternTableBytes(group.entries, group.entryBits), (group.entries + 1) / 2);
+            int positions[3];
+            for (uint64_t rank = 0; rank < group.entries; rank++){
+                int distance = placementManhattan(group, rank, positions);
+                CHECK_EQ(patternValue(group, rank, distance, -1, 0), (int)db.groups[g].table[rank]);
+            }
+        }
+    }
+}
+
+// Mod 3: solo tablas con el hueco libre; el valor sale del código y del
+// padre, y mod3Distance lo reconstruye sin padre
+TEST(pattern_db, mod3_encoding_round_trip) {
+    const vector<vector<int>> groups = {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}, {10, 11, 12}, {13, 14, 15}};
+    auto exact = generatePatternDB(groups, 4, true);
+    CHECK(encodePatternDB(smallPatternDB(), PDB_ENCODING_MOD3) == nullptr);
+    auto encoded = encodePatternDB(*exact, PDB_ENCODING_MOD3);
+    CHECK(encoded != nullptr);
+    if (encoded == nullptr)
+        return;
+    auto loaded = reloaded(*encoded);
+    CHECK(loaded != nullptr);
+    if (loaded == nullptr)
+        return;
+    for (size_t g = 0; g < groups.size(); g++){
+        const auto &bytes = exact->groups[g];
+        const auto &group = loaded->groups[g];
+        CHECK_EQ(group.entryBits, PDB_ENCODING_MOD3);
+        int positions[3];
+        for (uint64_t rank = 0; rank < group.entries; rank++){
+            int value = bytes.table[rank];
+            // Sin hueco la distancia no supera a la que lo cuenta
+            CHECK(value <= smallPatternDB().groups[g].table[rank]);
+            CHECK_EQ((int)patternCode(group, rank), value % 3);
+            CHECK_EQ(decodeMod3(value - 1, patternCode(group, rank)), value);
+            CHECK_EQ(decodeMod3(value + 1, patternCode(group, rank)), value);
+            if (rank % 37 == 0) {
+                placementManhattan(group, rank, positions);
+                CHECK_EQ(mod3Distance(group, positions, 4), value);
+            }
+        }
+    }
+}
+
+// Compresión con pérdida: el valor leído nunca supera al exacto y conserva
+// la paridad del Manhattan del grupo (la corrección de +1 al leer)
+TEST(pattern_db, compressed_tables_are_admissible) {
+    const PatternDatabase &db = smallPatternDB();
+    for (uint32_t compression : {2u, 5u, 14u}){
+        auto compressed = encodePatternDB(db, PDB_ENCODING_BYTE, compression);
+        CHECK(compressed != nullptr);
+        if (compressed == nullptr)
+            continue;
+        auto loaded = reloaded(*compressed);
+        CHECK(loaded != nullptr);
+        if (loaded == nullptr)
+            continue;
+        CHECK(encodePatternDB(*loaded, PDB_ENCODING_NIBBLE) == nullptr);
+        for (size_t g = 0; g < db.groups.size(); g++){
+            const auto &group = loaded->groups[g];
+            CHECK_EQ(group.compression, compression);
+            CHECK_EQ(patternTableBytes(group.entries, group.entryBits, group.compression),
+                     (group.entries + compression - 1) / compression);
+            int positions[3];
+            for (uint64_t rank = 0; rank < group.entries; rank++){
+                int distance = placementManhattan(group, rank, positions);
+                int value = patternValue(group, rank, distance, -1, 0);
+                CHECK(value <= db.groups[g].table[rank]);
+                CHECK_EQ((value - distance) & 1, 0);
+            }
+        }
+    }
+}
@@ -0,0 +1,56 @@
+// perimeter_test.cpp
+// Perímetro del objetivo: distancias exactas dentro, -1 fuera, y búsquedas
+// con perímetro que siguen siendo óptimas.
+
+#include "test_util.h"
+
+#include "solver/ida_star.h"
+#include "solver/perimeter.h"
+
+using namespace std;
+
+TEST(perimeter, distances_match_bfs) {
+    const int depth = 8;
+    auto perimeter = Perimeter::forDepth(depth);
+    CHECK(perimeter != nullptr);
+    if (perimeter == nullptr)
+        return;
+    CHECK(Perimeter::forDepth(depth) == perimeter);
+    CHECK(Perimeter::forDepth(0) == nullptr);
+    CHECK(Perimeter::forDepth(Perimeter::MAX_DEPTH + 1) == nullptr);
+    // Estados a distancia 0..8 del objetivo 4x4: 1, 2, 4, 10, 24, 54, 107, 212, 446
+    CHECK_EQ(perimeter->size(), (size_t)860);
+    for (uint32_t seed = 1; seed <= 40; seed++){
+        Puzzle puzzle = scrambledPuzzle(4, 4, 4 + (int)seed % 8, seed);
+        int distance = bfsDistance(puzzle, 12);
+        PackedState state = PackedState::fromPuzzle(puzzle);
+        CHECK_EQ(perimeter->distance(state.tiles), distance <= depth ? distance : -1);
+        if (distance > depth)
+            continue;
+        MovePath path;
+        CHECK(perimeter->appendPathToGoal(state, path));
+        CHECK_EQ(path.length, distance);
+        CHECK(replayToGoal(puzzle, path.toDirections()));
+    }
+}
+
+TEST(perimeter, solves_are_optimal) {
+    for (int depth : {4, 10}){
+        SearchOptions options;
+        options.perimeterDepth = depth;
+        for (const auto &board : referenceBoards()){
+            Moves moves = iterativeIDAStar(board.puzzle, smallPatternDB(), options);
+            CHECK(replayToGoal(board.puzzle, moves));
+            CHECK_EQ((int)moves.size(), board.distance);
+            moves = parallelIDAStar(board.puzzle, smallPatternDB(), sharedPool(), options);
+            CHECK(replayToGoal(board.puzzle, moves));
+            CHECK_EQ((int)moves.size(), board.distance);
+        }
+        Puzzle hard = scrambledPuzzle(4, 4, 80, 1);
+        options.orderMoves = true;
+        options.transpositionEntries = (size_t)1 << 16;
+        Moves moves = iterativeIDAStar(hard, smallPatternDB(), options);
+        CHECK(replayToGoal(hard, moves));
+        CHECK_EQ(moves.size(), iterativeIDAStar(hard, smallPatternDB()).size());
+    }
+}
@@ -0,0 +1,106 @@
+// puzzle_test.cpp
+// Representaciones del tablero y ranking de patrones.
+
+#include "test_util.h"
+
+#include <algorithm>
+
+using namespace std;
+
+TEST(puzzle, packed_state_round_trip) {
+    for (uint32_t seed = 1; seed <= 20; seed++){
+        Puzzle puzzle = scrambledPuzzle(4, 4, 40, seed);
+        PackedState state = PackedState::fromPuzzle(puzzle);
+        CHECK(state.toPuzzle().board == puzzle.board);
+        CHECK_EQ(state.blank, puzzle.blankRow * 4 + puzzle.blankCol);
+    }
+    CHECK(PackedState::fromPuzzle(Puzzle(4)).isGoal());
+}
+
+TEST(puzzle, packed_moves_match_puzzle) {
+    Puzzle puzzle(4);
+    PackedState state = PackedState::fromPuzzle(puzzle);
+    for (int step = 0; step < 500; step++){
+        int dir = (step * 7 + step / 3) % 4;
+        bool moved = puzzle.move(Puzzle::DIRECTIONS[dir].first, Puzzle::DIRECTIONS[dir].second);
+        CHECK_EQ(state.move(dir), moved);
+        CHECK(state.toPuzzle().board == puzzle.board);
+    }
+}
+
+TEST(puzzle, move_path_round_trip) {
+    MovePath path;
+    for (int i = 0; i < MovePath::MAX_DEPTH; i++){
+        path.push((i * 5 + i / 7) % 4);
+    }
+    for (int i = 0; i < MovePath::MAX_DEPTH; i++){
+        CHECK_EQ(path.at(i), (i * 5 + i / 7) % 4);
+    }
+    path.pop();
+    CHECK_EQ(path.length, MovePath::MAX_DEPTH - 1);
+    CHECK_EQ((int)path.toDirections().size(), MovePath::MAX_DEPTH - 1);
+}
+
+TEST(puzzle, parse_puzzle) {
+    Puzzle puzzle(4);
+    string error;
+    CHECK(parsePuzzle("1 2 3;4 5 6;7 8 0", puzzle, error));
+    CHECK(puzzle.rows == 3 && puzzle.cols == 3 && puzzle.checkWin());
+    CHECK(parsePuzzle("1 2 3 4;5 6 7 8;9 10 11 12;13 14 0 15", puzzle, error));
+    CHECK(puzzle.blankRow == 3 && puzzle.blankCol == 2);
+    CHECK(!parsePuzzle("1 2 3;4 5 6;7 8 8", puzzle, error));
+    CHECK(!parsePuzzle("1 2;3", puzzle, error));
+}
+
+// rankPattern es una biyección de las k-permutaciones de n celdas en
+// [0, n!/(n-k)!) y unrankPattern su inversa
+TEST(puzzle, rank_unrank_round_trip) {
+    for (int n : {4, 6, 9, 16}){
+        for (int k = 1; k <= 3; k++){
+            uint64_t count = permutationCount(n, k);
+            vector<bool> seen(count, false);
+            int positions[3];
+            for (uint64_t rank = 0; rank < count; rank++){
+                unrankPattern(rank, k, n, positions);
+                uint32_t used = 0;
+                for (int i = 0; i < k; i++){
+                    CHECK(positions[i] >= 0 && positions[i] < n && !(used & (1u << positions[i])));
+                    used |= 1u << positions[i];
+                }
+                uint64_t again = rankPattern(positions, k, n);
+                CHECK_EQ(again, rank);
+                if (again < count) {
+                    CHECK(!seen[again]);
+                    seen[again] = true;
+                }
+            }
+        }
+    }
+    CHECK_EQ(permutationCount(16, 8), 518918400ULL);
+    int last[8];
+    unrankPattern(permutationCount(16, 8) - 1, 8, 16, last);
+    CHECK_EQ(rankPattern(last, 8, 16), permutationCount(16, 8) - 1);
+}
+
+// isSolvable coincide con la alcanzabilidad por BFS para todas las
+// permutaciones de los tableros pequeños
+TEST(puzzle, solvable_matches_reachability) {
+    const int sizes[][2] = { {2, 2}, {2, 3}, {3, 2}, {2, 4}, {3, 3} };
+    for (const auto &size : sizes){
+        int rows = size[0], cols = size[1];
+        auto reachable = bfsFromGoal(rows, cols);
+        string key;
+        for (int tile = 0; tile < rows * cols; tile++){
+            key.push_back((char)('A' + tile));
+        }
+        size_t solvable = 0, total = 0;
+        do {
+            bool expected = reachable.count(key) > 0;
+            CHECK_EQ(isSolvable(puzzleFromKey(key, rows, cols)), expected);
+            solvable += expected ? 1 : 0;
+            total++;
+        } while (next_permutation(key.begin(), key.end()));
+        CHECK_EQ(solvable * 2, total);
+        CHECK_EQ(reachable.size(), solvable);
+    }
+}
@@ -0,0 +1,299 @@
+// search_test.cpp
+// Resolución 4x4: cada modo devuelve un camino que llega al objetivo con la
+// longitud óptima que da el BFS de referencia.
+
+#include "test_util.h"
+
+#include "solver/batch.h"
+#include "solver/heuristic.h"
+#include "solver/ida_star.h"
+#include "solver/pdb_generator.h"
+
+using namespace std;
+
+TEST(search, heuristic_is_admissible) {
+    for (const auto &board : referenceBoards()){
+        CHECK(board.distance >= 0);
+        CHECK(hScore(PackedState::fromPuzzle(board.puzzle), smallPatternDB()) <= board.distance);
+    }
+}
+
+// La heurística incremental coincide con la completa en todo un paseo
+TEST(search, incremental_heuristic_matches_full) {
+    const PatternDatabase &db = smallPatternDB();
+    PackedState state = PackedState::fromPuzzle(Puzzle(4));
+    IncrementalHeuristic heuristic(db);
+    heuristic.reset(state);
+    for (int step = 0; step < 400; step++){
+        int dir = (step * 13 + step / 5) % 4;
+        if (!state.canMove(dir))
+            continue;
+        int target = state.blank + PackedState::OFFSETS[dir];
+        HeuristicUndo undo;
+        heuristic.moveTile(state.tileAt(target), target, state.blank, undo);
+        state.applyMove(dir);
+        CHECK_EQ(heuristic.value(), hScore(state, db));
+    }
+}
+
+TEST(search, sequential_is_optimal) {
+    for (const auto &board : referenceBoards()){
+        SearchStats stats;
+        Moves moves = iterativeIDAStar(board.puzzle, smallPatternDB(), SearchOptions(), &stats);
+        CHECK(stats.status == SolveStatus::Solved);
+        CHECK(replayToGoal(board.puzzle, moves));
+        CHECK_EQ((int)moves.size(), board.distance);
+    }
+}
+
+TEST(search, parallel_is_optimal) {
+    for (const auto &board : referenceBoards()){
+        SearchStats stats;
+        Moves moves = parallelIDAStar(board.puzzle, smallPatternDB(), sharedPool(), SearchOptions(), &stats);
+        CHECK(stats.status == SolveStatus::Solved);
+        CHECK(replayToGoal(board.puzzle, moves));
+        CHECK_EQ((int)moves.size(), board.distance);
+    }
+}
+
+TEST(search, batch_is_optimal) {
+    vector<Puzzle> puzzles;
+    for (const auto &board : referenceBoards()){
+        puzzles.push_back(board.puzzle);
+    }
+    vector<BatchResult> results = solveBatch(puzzles, smallPatternDB(), sharedPool());
+    CHECK_EQ(results.size(), puzzles.size());
+    for (size_t i = 0; i < results.size() && i < puzzles.size(); i++){
+        Moves moves = movesFromLetters(results[i].moves);
+        CHECK(results[i].status == SolveStatus::Solved);
+        CHECK(replayToGoal(puzzles[i], moves));
+        CHECK_EQ((int)moves.size(), referenceBoards()[i].distance);
+    }
+}
+
+// El reflejo es una involución que conserva la distancia, así que el máximo
+// de ambas vistas sigue siendo admisible
+TEST(search, reflected_heuristic) {
+    const PatternDatabase &db = smallPatternDB();
+    const Reflection &reflection = Reflection::instance();
+    CHECK(reflection.reflect(PackedState::fromPuzzle(Puzzle(4))).isGoal());
+    for (const auto &board : referenceBoards()){
+        PackedState state = PackedState::fromPuzzle(board.puzzle);
+        PackedState reflected = reflection.reflect(state);
+        PackedState back = reflection.reflect(reflected);
+        CHECK(back.tiles == state.tiles && back.blank == state.blank);
+        CHECK_EQ(hScore(reflected, db, true), hScore(state, db, true));
+        CHECK(hScore(state, db) <= hScore(state, db, true));
+        CHECK(hScore(state, db, true) <= board.distance);
+    }
+    PackedState state = PackedState::fromPuzzle(Puzzle(4));
+    IncrementalHeuristic heuristic(db, true);
+    heuristic.reset(state);
+    for (int step = 0; step < 400; step++){
+        int dir = (step * 13 + step / 5) % 4;
+        if (!state.canMove(dir))
+            continue;
+        int target = state.blank + PackedState::OFFSETS[dir];
+        HeuristicUndo undo;
+        heuristic.moveTile(state.tileAt(target), target, state.blank, undo);
+        state.applyMove(dir);
+        CHECK_EQ(heuristic.value(), hScore(state, db, true));
+    }
+}
+
+TEST(search, reflected_solves_are_optimal) {
+    SearchOptions options;
+    options.reflect = true;
+    for (const auto &board : referenceBoards()){
+        Moves moves = iterativeIDAStar(board.puzzle, smallPatternDB(), options);
+        CHECK(replayToGoal(board.puzzle, moves));
+        CHECK_EQ((int)moves.size(), board.distance);
+        moves = parallelIDAStar(board.puzzle, smallPatternDB(), sharedPool(), options);
+        CHECK(replayToGoal(board.puzzle, moves));
+        CHECK_EQ((int)moves.size(), board.distance);
+    }
+}
+
+TEST(search, transposition_table_entries) {
+    TranspositionTable table(1000);
+    CHECK_EQ(table.capacity(), (size_t)512);
+    const uint64_t key = PackedState::GOAL, hash = PackedState::fromPuzzle(Puzzle(4)).hashKey();
+    CHECK(table.find(key, hash) == nullptr);
+    table.beginIteration();
+    table.recordVisit(key, hash, 5);
+    CHECK(table.isDuplicate(table.find(key, hash), 5));
+    CHECK(table.isDuplicate(table.find(key, hash), 7));
+    CHECK(!table.isDuplicate(table.find(key, hash), 4));
+    table.recordVisit(key, hash, 3);
+    CHECK(table.isDuplicate(table.find(key, hash), 4));
+    // Las visitas de iteraciones anteriores no cuentan; la h aprendida sí
+    table.learn(key, hash, 12);
+    table.learn(key, hash, 8);
+    table.beginIteration();
+    CHECK(!table.isDuplicate(table.find(key, hash), 10));
+    CHECK_EQ((int)table.find(key, hash)->h, 12);
+}
+
+// Con tabla (también una diminuta, que reemplaza sin parar) la solución
+// sigue siendo óptima
+TEST(search, transposition_solves_are_optimal) {
+    for (size_t entries : {(size_t)4, (size_t)1 << 16}){
+        SearchOptions options;
+        options.transpositionEntries = entries;
+        for (const auto &board : referenceBoards()){
+            SearchStats stats;
+            Moves moves = iterativeIDAStar(board.puzzle, smallPatternDB(), options, &stats);
+            CHECK(replayToGoal(board.puzzle, moves));
+            CHECK_EQ((int)moves.size(), board.distance);
+        }
+        Puzzle hard = scrambledPuzzle(4, 4, 80, 1);
+        Moves expected = iterativeIDAStar(hard, smallPatternDB());
+        Moves moves = iterativeIDAStar(hard, smallPatternDB(), options);
+        CHECK(replayToGoal(hard, moves));
+        CHECK_EQ(moves.size(), expected.size());
+    }
+}
+
+// El orden de los hijos cambia el camino, no su longitud
+TEST(search, ordered_solves_are_optimal) {
+    SearchOptions options;
+    options.orderMoves = true;
+    for (const auto &board : referenceBoards()){
+        Moves moves = iterativeIDAStar(board.puzzle, smallPatternDB(), options);
+        CHECK(replayToGoal(board.puzzle, moves));
+        CHECK_EQ((int)moves.size(), board.distance);
+        moves = parallelIDAStar(board.puzzle, smallPatternDB(), sharedPool(), options);
+        CHECK(replayToGoal(board.puzzle, moves));
+        CHECK_EQ((int)moves.size(), board.distance);
+    }
+    Puzzle hard = scrambledPuzzle(4, 4, 80, 1);
+    Moves expected = iterativeIDAStar(hard, smallPatternDB());
+    options.transpositionEntries = (size_t)1 << 16;
+    Moves moves = iterativeIDAStar(hard, smallPatternDB(), options);
+    CHECK(replayToGoal(hard, moves));
+    CHECK_EQ(moves.size(), expected.size());
+    moves = parallelIDAStar(hard, smallPatternDB(), sharedPool(), options);
+    CHECK(replayToGoal(hard, moves));
+    CHECK_EQ(moves.size(), expected.size());
+}
+
+// Las codificaciones compactas dan los mismos caminos óptimos, y la
+// heurística incremental sigue coincidiendo con la completa
+TEST(search, encoded_solves_are_optimal) {
+    auto nibble = encodePatternDB(smallPatternDB(), PDB_ENCODING_NIBBLE);
+    auto mod3 = encodePatternDB(*generatePatternDB({{1, 2, 3}, {4, 5, 6}, {7, 8, 9}, {10, 11, 12}, {13, 14, 15}}, 4, true),
+                                PDB_ENCODING_MOD3);
+    CHECK(nibble != nullptr && mod3 != nullptr);
+    if (nibble == nullptr || mod3 == nullptr)
+        return;
+    for (const PatternDatabase* db : {(const PatternDatabase*)nibble.get(), (const PatternDatabase*)mod3.get()}){
+        PackedState state = PackedState::fromPuzzle(Puzzle(4));
+        IncrementalHeuristic heuristic(*db);
+        heuristic.reset(state);
+        for (int step = 0; step < 300; step++){
+            int dir = (step * 13 + step / 5) % 4;
+            if (!state.canMove(dir))
+                continue;
+            int target = state.blank + PackedState::OFFSETS[dir];
+            HeuristicUndo undo;
+            heuristic.moveTile(state.tileAt(target), target, state.blank, undo);
+            state.applyMove(dir);
+            CHECK_EQ(heuristic.value(), hScore(state, *db));
+        }
+        for (const auto &board : referenceBoards()){
+            Moves moves = iterativeIDAStar(board.puzzle, *db);
+            CHECK(replayToGoal(board.puzzle, moves));
+            CHECK_EQ((int)moves.size(), board.distance);
+            moves = parallelIDAStar(board.puzzle, *db, sharedPool());
+            CHECK(replayToGoal(board.puzzle, moves));
+            CHECK_EQ((int)moves.size(), board.distance);
+        }
+    }
+}
+
+TEST(search, compressed_solves_are_optimal) {
+    auto compressed = encodePatternDB(smallPatternDB(), PDB_ENCODING_BYTE, 14);
+    CHECK(compressed != nullptr);
+    if (compressed == nullptr)
+        return;
+    PackedState state = PackedState::fromPuzzle(Puzzle(4));
+    IncrementalHeuristic heuristic(*compressed, true);
+    heuristic.reset(state);
+    for (int step = 0; step < 300; step++){
+        int dir = (step * 13 + step / 5) % 4;
+        if (!state.canMove(dir))
+            continue;
+        int target = state.blank + PackedState::OFFSETS[dir];
+        HeuristicUndo undo;
+        heuristic.moveTile(state.tileAt(target), target, state.blank, undo);
+        state.applyMove(dir);
+        CHECK_EQ(heuristic.value(), hScore(state, *compressed, true));
+    }
+    for (const auto &board : referenceBoards()){
+        CHECK(hScore(PackedState::fromPuzzle(board.puzzle), *compressed, true) <= board.distance);
+        Moves moves = iterativeIDAStar(board.puzzle, *compressed);
+        CHECK(replayToGoal(board.puzzle, moves));
+        CHECK_EQ((int)moves.size(), board.distance);
+    }
+    Puzzle hard = scrambledPuzzle(4, 4, 80, 2);
+    CHECK_EQ(iterativeIDAStar(hard, *compressed).size(), iterativeIDAStar(hard, smallPatternDB()).size());
+}
+
+// ------------------------------------------------------
+// IDA* con peso y costLimit
+// ------------------------------------------------------
+TEST(search, weighted_cost) {
+    CHECK(!WeightedCost(1.0).weighted());
+    CHECK(!WeightedCost(0.5).weighted());
+    WeightedCost cost(2.0);
+    CHECK(cost.weighted());
+    CHECK(cost.weight() == 2.0);
+    CHECK_EQ(cost.f(10, 5), 16 * 10 + 32 * 5);
+    CHECK_EQ(cost.lowerBound(32 * 20), 20);
+    CHECK_EQ(cost.lowerBound(32 * 20 + 1), 21);
+    CHECK(WeightedCost(100.0).weight() == MAX_SEARCH_WEIGHT);
+    CHECK(cost.suboptimality(30, 32 * 20) == 1.5);
+    CHECK(cost.suboptimality(20, 32 * 20) == 1.0);
+}
+
+// La solución mide como mucho w veces la óptima y el factor informado
+// acota su longitud real
+TEST(search, weighted_solves_are_bounded) {
+    for (uint32_t seed = 1; seed <= 3; seed++){
+        Puzzle hard = scrambledPuzzle(4, 4, 80, seed);
+        int optimal = (int)iterativeIDAStar(hard, smallPatternDB()).size();
+        for (double weight : {1.5, 2.0, 3.0}){
+            SearchOptions options;
+            options.weight = weight;
+            for (bool parallel : {false, true}){
+                SearchStats stats;
+                Moves moves = parallel ? parallelIDAStar(hard, smallPatternDB(), sharedPool(), options, &stats)
+                                       : iterativeIDAStar(hard, smallPatternDB(), options, &stats);
+                CHECK(stats.status == SolveStatus::Solved);
+                CHECK(replayToGoal(hard, moves));
+                CHECK((int)moves.size() <= weight * optimal);
+                CHECK(stats.suboptimality >= 1.0 && stats.suboptimality <= weight);
+                CHECK((int)moves.size() <= stats.suboptimality * optimal + 1e-9);
+                CHECK(stats.bound <= optimal);
+            }
+        }
+    }
+}
+
+// costLimit: solo soluciones más cortas; NoSolution prueba que no las hay
+TEST(search, cost_limit) {
+    Puzzle hard = scrambledPuzzle(4, 4, 80, 2);
+    int optimal = (int)iterativeIDAStar(hard, smallPatternDB()).size();
+    SearchOptions options;
+    options.costLimit = optimal;
+    SearchStats stats;
+    CHECK(iterativeIDAStar(hard, smallPatternDB(), options, &stats).empty());
+    CHECK(stats.status == SolveStatus::NoSolution);
+    parallelIDAStar(hard, smallPatternDB(), sharedPool(), options, &stats);
+    CHECK(stats.status == SolveStatus::NoSolution);
+    options.costLimit = optimal + 1;
+    Moves moves = iterativeIDAStar(hard, smallPatternDB(), options, &stats);
+    CHECK(stats.status == SolveStatus::Solved);
+    CHECK(replayToGoal(hard, moves));
+    CHECK_EQ((int)moves.size(), optimal);
+}
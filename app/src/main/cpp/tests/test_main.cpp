@@ -0,0 +1,54 @@
+// test_main.cpp
+// Ejecuta las pruebas registradas con TEST. Uso: patterndb_tests [suite]
+// (ctest lanza una vez por suite). Retorna 1 si falló alguna comprobación.
+
+#include "test_util.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+using namespace std;
+
+struct RegisteredTest {
+    const char* suite;
+    const char* name;
+    TestFunction function;
+};
+
+// Registro construido en la inicialización estática de cada archivo de pruebas
+static vector<RegisteredTest>& registeredTests() {
+    static vector<RegisteredTest> tests;
+    return tests;
+}
+
+static int failures = 0;
+
+TestRegistration::TestRegistration(const char* suite, const char* name, TestFunction function) {
+    registeredTests().push_back({suite, name, function});
+}
+
+void checkFailed(const char* file, int line, const string& message) {
+    failures++;
+    fprintf(stderr, "%s:%d: falló %s\n", file, line, message.c_str());
+}
+
+int main(int argc, char** argv) {
+    const char* suite = argc > 1 ? argv[1] : nullptr;
+    int run = 0;
+    for (const auto &test : registeredTests()){
+        if (suite != nullptr && strcmp(suite, test.suite) != 0)
+            continue;
+        int before = failures;
+        auto start = chrono::steady_clock::now();
+        test.function();
+        long long millis = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+        printf("%s %s.%s (%lld ms)\n", failures == before ? "ok  " : "FAIL", test.suite, test.name, millis);
+        run++;
+    }
+    if (run == 0) {
+        fprintf(stderr, "no hay pruebas en la suite %s\n", suite != nullptr ? suite : "");
+        return 1;
+    }
+    return failures == 0 ? 0 : 1;
+}
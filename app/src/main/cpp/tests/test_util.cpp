@@ -0,0 +1,135 @@
+// test_util.cpp
+
+#include "test_util.h"
+
+#include "solver/pdb_generator.h"
+
+#include <deque>
+#include <random>
+
+using namespace std;
+
+Puzzle scrambledPuzzle(int rows, int cols, int steps, uint32_t seed) {
+    Puzzle puzzle(rows, cols);
+    mt19937 random(seed);
+    int last = -1;
+    for (int done = 0; done < steps; ){
+        int dir = (int)(random() % 4);
+        if (last >= 0 && dir == oppositeDirection(last))
+            continue;
+        if (!puzzle.move(Puzzle::DIRECTIONS[dir].first, Puzzle::DIRECTIONS[dir].second))
+            continue;
+        last = dir;
+        done++;
+    }
+    return puzzle;
+}
+
+bool replayToGoal(const Puzzle& start, const Moves& moves) {
+    Puzzle puzzle = start;
+    for (auto move : moves){
+        if (!puzzle.move(move.first, move.second))
+            return false;
+    }
+    return puzzle.checkWin();
+}
+
+Moves movesFromLetters(const string& letters) {
+    Moves moves;
+    for (char letter : letters){
+        for (int dir = 0; dir < 4; dir++){
+            if (MOVE_LETTERS[dir] == letter)
+                moves.push_back(Puzzle::DIRECTIONS[dir]);
+        }
+    }
+    return moves;
+}
+
+vector<int> boardTiles(const Puzzle& puzzle) {
+    vector<int> tiles;
+    for (const auto &row : puzzle.board){
+        tiles.insert(tiles.end(), row.begin(), row.end());
+    }
+    return tiles;
+}
+
+string boardKey(const Puzzle& puzzle) {
+    string key;
+    for (const auto &row : puzzle.board){
+        for (int tile : row){
+            key.push_back((char)('A' + tile));
+        }
+    }
+    return key;
+}
+
+Puzzle puzzleFromKey(const string& key, int rows, int cols) {
+    Puzzle puzzle(rows, cols);
+    for (int cell = 0; cell < rows * cols; cell++){
+        int tile = key[cell] - 'A';
+        puzzle.board[cell / cols][cell % cols] = tile;
+        if (tile == 0) {
+            puzzle.blankRow = cell / cols;
+            puzzle.blankCol = cell % cols;
+        }
+    }
+    return puzzle;
+}
+
+// BFS por capas desde start; goalKey vacío recorre todo el espacio
+static unordered_map<string, int> bfsLayers(const Puzzle& start, int maxDepth, const string& goalKey) {
+    unordered_map<string, int> distance;
+    deque<string> queue;
+    distance[boardKey(start)] = 0;
+    queue.push_back(boardKey(start));
+    while (!queue.empty()) {
+        string key = queue.front();
+        queue.pop_front();
+        int d = distance[key];
+        if (key == goalKey || d == maxDepth)
+            continue;
+        Puzzle puzzle = puzzleFromKey(key, start.rows, start.cols);
+        for (const auto &dir : Puzzle::DIRECTIONS){
+            auto child = puzzle.simulateMove(dir);
+            if (!child.first)
+                continue;
+            string childKey = boardKey(child.second);
+            if (distance.emplace(childKey, d + 1).second) {
+                if (childKey == goalKey)
+                    return distance;
+                queue.push_back(childKey);
+            }
+        }
+    }
+    return distance;
+}
+
+int bfsDistance(const Puzzle& start, int maxDepth) {
+    string goalKey = boardKey(Puzzle(start.rows, start.cols));
+    auto distance = bfsLayers(start, maxDepth, goalKey);
+    auto it = distance.find(goalKey);
+    return it != distance.end() ? it->second : -1;
+}
+
+unordered_map<string, int> bfsFromGoal(int rows, int cols) {
+    return bfsLayers(Puzzle(rows, cols), -1, string());
+}
+
+const PatternDatabase& smallPatternDB() {
+    static shared_ptr<PatternDatabase> db =
+            generatePatternDB({{1, 2, 3}, {4, 5, 6}, {7, 8, 9}, {10, 11, 12}, {13, 14, 15}}, PackedState::SIDE);
+    return *db;
+}
+
+const vector<ReferenceBoard>& referenceBoards() {
+    static vector<ReferenceBoard> boards = [] {
+        vector<ReferenceBoard> result;
+        result.push_back({Puzzle(4), 0});
+        for (uint32_t seed = 1; seed <= 8; seed++){
+            Puzzle puzzle = scrambledPuzzle(4, 4, 6 + (int)seed, seed);
+            result.push_back({puzzle, bfsDistance(puzzle, 14)});
+        }
+        return result;
+    }();
+    return boards;
+}
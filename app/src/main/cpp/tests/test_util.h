@@ -0,0 +1,95 @@
+// test_util.h
+// Arnés mínimo de las pruebas del núcleo (sin dependencias externas) y
+// utilidades comunes: tableros mezclados, reproducción de caminos y
+// distancias exactas por BFS para comprobar los solvers.
+#pragma once
+
+#include "solver/pattern_db.h"
+#include "solver/puzzle.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// ------------------------------------------------------
+// Registro de pruebas: TEST(suite, nombre) registra "suite.nombre" y
+// test_main ejecuta las de la suite que recibe como argumento (todas sin
+// argumento). Los CHECK no abortan la prueba: cuentan el fallo y siguen.
+// ------------------------------------------------------
+typedef void (*TestFunction)();
+
+struct TestRegistration {
+    TestRegistration(const char* suite, const char* name, TestFunction function);
+};
+
+void checkFailed(const char* file, int line, const std::string& message);
+
+#define TEST(suite, name) \
+    static void suite##_##name(); \
+    static TestRegistration suite##_##name##_registration(#suite, #name, suite##_##name); \
+    static void suite##_##name()
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) \
+            checkFailed(__FILE__, __LINE__, #condition); \
+    } while (0)
+
+#define CHECK_EQ(actual, expected) \
+    do { \
+        auto checkActual = (actual); \
+        auto checkExpected = (expected); \
+        if (!(checkActual == checkExpected)) \
+            checkFailed(__FILE__, __LINE__, std::string(#actual " == " #expected ": ") + \
+                        std::to_string(checkActual) + " != " + std::to_string(checkExpected)); \
+    } while (0)
+
+// ------------------------------------------------------
+// Tableros y caminos
+// ------------------------------------------------------
+typedef std::vector<std::pair<int,int>> Moves;
+
+// Paseo aleatorio de steps movimientos desde el objetivo sin deshacer el
+// anterior (semilla fija: las pruebas son deterministas). La distancia
+// óptima es como mucho steps.
+Puzzle scrambledPuzzle(int rows, int cols, int steps, uint32_t seed);
+
+// Aplica moves (movimientos del hueco) a start: true si todos son válidos y
+// el tablero termina resuelto
+bool replayToGoal(const Puzzle& start, const Moves& moves);
+
+// Movimientos a partir de letras de MOVE_LETTERS
+Moves movesFromLetters(const std::string& letters);
+
+// Fichas en orden fila-mayor (para la API C)
+std::vector<int> boardTiles(const Puzzle& puzzle);
+
+// ------------------------------------------------------
+// BFS de referencia sobre Puzzle (lento pero obvio)
+// ------------------------------------------------------
+// Clave de un tablero: una letra por celda
+std::string boardKey(const Puzzle& puzzle);
+Puzzle puzzleFromKey(const std::string& key, int rows, int cols);
+
+// Distancia óptima de start al objetivo, o -1 si es mayor que maxDepth
+int bfsDistance(const Puzzle& start, int maxDepth);
+
+// Distancia al objetivo de todos los tableros alcanzables (tableros pequeños)
+std::unordered_map<std::string, int> bfsFromGoal(int rows, int cols);
+
+// ------------------------------------------------------
+// Casos 4x4 comunes: PatternDB pequeña (cinco grupos de 3 fichas) y
+// tableros con su distancia óptima, generados una vez
+// ------------------------------------------------------
+const PatternDatabase& smallPatternDB();
+
+struct ReferenceBoard {
+    Puzzle puzzle;
+    int distance;
+};
+
+// El objetivo y paseos de 7 a 14 movimientos (el BFS sigue siendo rápido)
+const std::vector<ReferenceBoard>& referenceBoards();
@@ -0,0 +1,327 @@
+// pdb_tool.cpp
+// Herramienta de línea de comandos sobre la API C del solver.
+//   pdb_tool generate <5-5-5|6-6-3|7-8|6-6-6-6> <salida.pdb> [--bits <8|4|2> | --compress <n>]
+//   pdb_tool encode <patterndb> <salida.pdb> (--bits <8|4|2> | --compress <n>) [--size <n>]
+//   pdb_tool convert <entrada.json> <salida.pdb>
+//   pdb_tool distance <filas> <columnas> <salida.dst>
+//   pdb_tool solve <patterndb> [--size <n>] [--parallel | --batch] [--reflect]
+//                  [--timeout-ms <n>] [--max-nodes <n>] [--tt-mb <n>] [--order]
+//                  [--perimeter <d>] [--weight <w>] [--anytime] < tableros
+//   pdb_tool bench <patterndb> [opciones de solve] < tableros
+//   pdb_tool solve-grid [--timeout-ms <n>] [--max-nodes <n>] [--weight <w>] [--anytime] < tableros
+// Cada línea de la entrada estándar es un tablero (4x4 o el de --size, que
+// debe coincidir con la PatternDB) en el formato de la app
+// ("1 2 3 4;5 6 7 8;9 10 11 12;13 14 15 0"). Por tablero se imprime
+// "movimientos longitud nodos microsegundos" (más el factor probado respecto
+// al óptimo si --weight o --anytime lo hacen mayor que 1) o el error (con "nodos cota" si
+// lo detuvo un límite). bench resuelve cada tablero en secuencial con las
+// opciones y sin las mejoras opcionales de la búsqueda (tabla de
+// transposiciones, orden de hijos, perímetro, peso, anytime) y compara
+// nodos, tiempo y, con peso o anytime, longitud.
+// <patterndb> es un .pdb, un JSON o builtin:linear-conflict /
+// builtin:walking-distance.
+// solve-grid acepta tableros de 2x2 a 6x6, también rectangulares, y los
+// resuelve sin PatternDB (con la tabla de distancias del tamaño si la hay).
+// --bits elige los bits por entrada de las tablas (ver pdb_generate_encoded)
+// y --compress la compresión con pérdida (ver pdb_generate_compressed).
+
+#include "solver/patterndb_c.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+const int DEFAULT_BOARD_SIZE = 4;
+
+int usage() {
+    cerr << "uso: pdb_tool generate <5-5-5|6-6-3|7-8|6-6-6-6> <salida.pdb> [--bits <8|4|2> | --compress <n>]\n"
+         << "     pdb_tool encode <patterndb> <salida.pdb> (--bits <8|4|2> | --compress <n>) [--size <n>]\n"
+         << "     pdb_tool convert <entrada.json> <salida.pdb>\n"
+         << "     pdb_tool distance <filas> <columnas> <salida.dst>\n"
+         << "     pdb_tool solve <patterndb> [--size <n>] [--parallel | --batch] [--reflect]\n"
+         << "                    [--timeout-ms <n>] [--max-nodes <n>] [--tt-mb <n>] [--order]\n"
+         << "                    [--perimeter <d>] [--weight <w>] [--anytime] < tableros\n"
+         << "     pdb_tool bench <patterndb> [opciones de solve] < tableros\n"
+         << "     pdb_tool solve-grid [--timeout-ms <n>] [--max-nodes <n>] [--weight <w>] [--anytime] < tableros\n";
+    return 2;
+}
+
+const char* statusName(pdb_status status) {
+    switch (status) {
+        case PDB_STATUS_SOLVED: return "solved";
+        case PDB_STATUS_NO_SOLUTION: return "no-solution";
+        case PDB_STATUS_INVALID_INPUT: return "invalid-input";
+        case PDB_STATUS_UNSOLVABLE: return "unsolvable";
+        case PDB_STATUS_CANCELLED: return "cancelled";
+        case PDB_STATUS_TIMEOUT: return "timeout";
+        case PDB_STATUS_BUDGET_EXHAUSTED: return "budget-exhausted";
+        default: return "no-database";
+    }
+}
+
+void printResult(const pdb_solve_result &result) {
+    if (result.status == PDB_STATUS_TIMEOUT || result.status == PDB_STATUS_BUDGET_EXHAUSTED) {
+        cout << "error " << statusName(result.status) << " " << result.nodes << " " << result.bound << "\n";
+        return;
+    }
+    if (result.status != PDB_STATUS_SOLVED) {
+        cout << "error " << statusName(result.status) << "\n";
+        return;
+    }
+    cout << (result.length > 0 ? result.moves : "-") << " " << result.length << " "
+         << result.nodes << " " << result.micros;
+    if (result.suboptimality > 1.0)
+        cout << " " << result.suboptimality;
+    cout << "\n";
+}
+
+// Lee los tableros de stdin; los que no tienen boardSize² números quedan como {-1, ...}
+vector<int> readBoards(int boardSize, int &count) {
+    vector<int> tiles;
+    string line;
+    count = 0;
+    while (getline(cin, line)) {
+        for (char &c : line){
+            if (c == ';')
+                c = ' ';
+        }
+        istringstream iss(line);
+        vector<int> board;
+        int value;
+        while (iss >> value) {
+            board.push_back(value);
+        }
+        if (board.empty())
+            continue;
+        if ((int)board.size() != boardSize * boardSize)
+            board.assign(boardSize * boardSize, -1);
+        tiles.insert(tiles.end(), board.begin(), board.end());
+        count++;
+    }
+    return tiles;
+}
+
+// Cada línea es un tablero de cualquier tamaño; las filas separadas por ';'
+int solveGrids(const pdb_options &options) {
+    string line;
+    int count = 0;
+    uint64_t totalNodes = 0;
+    auto start = chrono::steady_clock::now();
+    while (getline(cin, line)) {
+        vector<int> tiles;
+        int rows = 0, cols = 0;
+        istringstream lineStream(line);
+        string rowStr;
+        while (getline(lineStream, rowStr, ';')) {
+            istringstream rowStream(rowStr);
+            int value, width = 0;
+            while (rowStream >> value) {
+                tiles.push_back(value);
+                width++;
+            }
+            if (rows == 0)
+                cols = width;
+            else if (width != cols)
+                cols = -1;
+            rows++;
+        }
+        if (tiles.empty())
+            continue;
+        // La tabla de distancias del tamaño se prepara fuera de la resolución
+        if (cols > 0)
+            pdb_preload_distance_table(rows, cols);
+        pdb_solve_result result;
+        pdb_solve_grid(tiles.data(), rows, cols, &options, &result);
+        printResult(result);
+        totalNodes += result.nodes;
+        count++;
+    }
+    auto micros = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    cerr << count << " tableros, " << totalNodes << " nodos, " << micros << " us\n";
+    return 0;
+}
+
+int solve(const char* dbPath, int boardSize, bool batch, const pdb_options &options) {
+    pdb_database* db = pdb_load(dbPath, boardSize);
+    if (db == nullptr) {
+        cerr << "no se pudo cargar " << dbPath << "\n";
+        return 1;
+    }
+    int count;
+    vector<int> tiles = readBoards(boardSize, count);
+    auto start = chrono::steady_clock::now();
+    uint64_t totalNodes = 0;
+    if (batch) {
+        vector<pdb_solve_result> results((size_t)count);
+        pdb_solve_batch(db, tiles.data(), count, boardSize, &options, results.data());
+        for (const auto &result : results){
+            printResult(result);
+            totalNodes += result.nodes;
+        }
+    } else {
+        for (int i = 0; i < count; i++){
+            pdb_solve_result result;
+            pdb_solve(db, tiles.data() + (size_t)i * boardSize * boardSize, boardSize, &options, &result);
+            printResult(result);
+            totalNodes += result.nodes;
+        }
+    }
+    auto micros = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    cerr << count << " tableros, " << totalNodes << " nodos, " << micros << " us\n";
+    pdb_release(db);
+    return 0;
+}
+
+// Las mismas opciones sin las mejoras opcionales de la búsqueda
+pdb_options baselineOf(const pdb_options &options) {
+    pdb_options baseline = options;
+    baseline.transposition_mb = 0;
+    baseline.order_moves = 0;
+    baseline.perimeter_depth = 0;
+    baseline.weight = 0;
+    baseline.anytime = 0;
+    return baseline;
+}
+
+int bench(const char* dbPath, int boardSize, const pdb_options &options) {
+    pdb_database* db = pdb_load(dbPath, boardSize);
+    if (db == nullptr) {
+        cerr << "no se pudo cargar " << dbPath << "\n";
+        return 1;
+    }
+    int count;
+    vector<int> tiles = readBoards(boardSize, count);
+    pdb_options baseline = baselineOf(options);
+    uint64_t totalNodes[2] = {0, 0};
+    int64_t totalMicros[2] = {0, 0};
+    int totalLength[2] = {0, 0};
+    bool suboptimal = options.weight > 1.0 || options.anytime;
+    cout << "longitud nodos_base nodos us_base us\n";
+    for (int i = 0; i < count; i++){
+        const int* board = tiles.data() + (size_t)i * boardSize * boardSize;
+        pdb_solve_result results[2];
+        pdb_solve(db, board, boardSize, &baseline, &results[0]);
+        pdb_solve(db, board, boardSize, &options, &results[1]);
+        if (results[0].status != PDB_STATUS_SOLVED || results[1].status != PDB_STATUS_SOLVED) {
+            cout << "error " << statusName(results[0].status) << " " << statusName(results[1].status) << "\n";
+            continue;
+        }
+        if (results[0].length != results[1].length && !suboptimal)
+            cerr << "tablero " << i << ": longitudes distintas\n";
+        cout << results[1].length << " " << results[0].nodes << " " << results[1].nodes << " "
+             << results[0].micros << " " << results[1].micros << "\n";
+        for (int k = 0; k < 2; k++){
+            totalNodes[k] += results[k].nodes;
+            totalMicros[k] += results[k].micros;
+            totalLength[k] += results[k].length;
+        }
+    }
+    cout << "total " << totalNodes[0] << " " << totalNodes[1] << " " << totalMicros[0] << " " << totalMicros[1] << "\n";
+    if (totalNodes[0] > 0 && totalMicros[0] > 0)
+        cout << "relación nodos " << (double)totalNodes[1] / totalNodes[0]
+             << " tiempo " << (double)totalMicros[1] / totalMicros[0] << "\n";
+    if (suboptimal && totalLength[0] > 0)
+        cout << "relación longitud " << (double)totalLength[1] / totalLength[0] << "\n";
+    pdb_release(db);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2)
+        return usage();
+    string command = argv[1];
+    if ((command == "generate" || command == "encode") && argc >= 4) {
+        int entryBits = command == "generate" ? 8 : 0;
+        int compression = 0;
+        int boardSize = DEFAULT_BOARD_SIZE;
+        for (int i = 4; i < argc; i++){
+            string flag = argv[i];
+            if (flag == "--bits" && i + 1 < argc)
+                entryBits = stoi(argv[++i]);
+            else if (flag == "--compress" && i + 1 < argc)
+                compression = stoi(argv[++i]);
+            else if (flag == "--size" && i + 1 < argc && command == "encode")
+                boardSize = stoi(argv[++i]);
+            else
+                return usage();
+        }
+        if (compression > 0) {
+            if (entryBits != 0 && entryBits != 8)
+                return usage();
+            if (command == "generate")
+                return pdb_generate_compressed(argv[2], argv[3], compression) ? 0 : 1;
+            return pdb_compress(argv[2], boardSize, argv[3], compression) ? 0 : 1;
+        }
+        if (entryBits == 0)
+            return usage();
+        if (command == "generate")
+            return pdb_generate_encoded(argv[2], argv[3], entryBits) ? 0 : 1;
+        return pdb_encode(argv[2], boardSize, argv[3], entryBits) ? 0 : 1;
+    }
+    if (command == "convert" && argc == 4)
+        return pdb_convert(argv[2], DEFAULT_BOARD_SIZE, argv[3]) ? 0 : 1;
+    if (command == "distance" && argc == 5)
+        return pdb_generate_distance_table(stoi(argv[2]), stoi(argv[3]), argv[4]) ? 0 : 1;
+    if (command == "solve-grid") {
+        pdb_options options;
+        pdb_options_init(&options);
+        for (int i = 2; i < argc; i++){
+            string flag = argv[i];
+            if (flag == "--timeout-ms" && i + 1 < argc)
+                options.timeout_micros = stoll(argv[++i]) * 1000;
+            else if (flag == "--max-nodes" && i + 1 < argc)
+                options.max_nodes = stoull(argv[++i]);
+            else if (flag == "--weight" && i + 1 < argc)
+                options.weight = stod(argv[++i]);
+            else if (flag == "--anytime")
+                options.anytime = 1;
+            else
+                return usage();
+        }
+        return solveGrids(options);
+    }
+    if ((command == "solve" || command == "bench") && argc >= 3) {
+        pdb_options options;
+        pdb_options_init(&options);
+        bool batch = false;
+        int boardSize = DEFAULT_BOARD_SIZE;
+        for (int i = 3; i < argc; i++){
+            string flag = argv[i];
+            if (flag == "--size" && i + 1 < argc)
+                boardSize = stoi(argv[++i]);
+            else if (flag == "--parallel")
+                options.parallel = 1;
+            else if (flag == "--batch")
+                batch = true;
+            else if (flag == "--reflect")
+                options.reflect = 1;
+            else if (flag == "--timeout-ms" && i + 1 < argc)
+                options.timeout_micros = stoll(argv[++i]) * 1000;
+            else if (flag == "--max-nodes" && i + 1 < argc)
+                options.max_nodes = stoull(argv[++i]);
+            else if (flag == "--tt-mb" && i + 1 < argc)
+                options.transposition_mb = stoi(argv[++i]);
+            else if (flag == "--order")
+                options.order_moves = 1;
+            else if (flag == "--perimeter" && i + 1 < argc)
+                options.perimeter_depth = stoi(argv[++i]);
+            else if (flag == "--weight" && i + 1 < argc)
+                options.weight = stod(argv[++i]);
+            else if (flag == "--anytime")
+                options.anytime = 1;
+            else
+                return usage();
+        }
+        if (batch && options.parallel)
+            return usage();
+        if (command == "bench")
+            return batch || options.parallel ? usage() : bench(argv[2], boardSize, options);
+        return solve(argv[2], boardSize, batch, options);
+    }
+    return usage();
+}
@@ -7,5 +7,41 @@ public class NativeSolver {
         System.loadLibrary("native-lib");
     }
     public native void setAssetManager(AssetManager assetManager);
+    // Carga la PatternDB una sola vez por proceso; solvePuzzle reutiliza la instancia cacheada.
+    // filename puede ser un asset (.json o .pdb) o una ruta absoluta a un .pdb.
+    public native boolean preloadPatternDB(String filename, int boardSize);
+    // Convierte una PatternDB JSON (asset o ruta) al formato binario .pdb en outPath
+    public native boolean convertPatternDB(String jsonFilename, int boardSize, String outPath);
+    // Genera una PatternDB aditiva ("5-5-5" o "6-6-3") en outPath; tarea larga, fuera del hilo de UI.
+    // "7-8" y "6-6-6-6" no caben en memoria en un dispositivo: retorna false (generarlas con pdb_tool).
+    public native boolean generatePatternDB(String partition, String outPath);
+    // Resuelve en el hilo que llama y bloquea hasta tener el resultado: desde la UI usar solvePuzzleAsync.
+    // Se puede llamar desde un SolveCallback.
     public native String solvePuzzle(String puzzleMatrix);
+    // Igual que solvePuzzle pero reparte la búsqueda entre todos los núcleos
+    public native String solvePuzzleParallel(String puzzleMatrix);
+    // solvePuzzle con tiempo máximo (ms) y presupuesto de nodos; 0 no limita.
+    // Si se detiene retorna el motivo, los nodos generados y la cota inferior alcanzada.
+    public native String solvePuzzleWithLimits(String puzzleMatrix, boolean parallel, long timeoutMillis, long maxNodes);
+    // solvePuzzleWithLimits con f = g + weight·h (weight de 1 a 8; 1 es óptima): solución de como
+    // mucho weight veces la óptima, mucho más rápida; al final indica el factor probado.
+    public native String solvePuzzleWeighted(String puzzleMatrix, boolean parallel, double weight, long timeoutMillis,
+                                             long maxNodes);
+    // Mejor solución encontrada en timeoutMillis (primero una rápida con peso, después más cortas),
+    // con el factor respecto al óptimo si no llegó a probarla óptima. 0: hasta la óptima.
+    public native String solvePuzzleAnytime(String puzzleMatrix, long timeoutMillis);
+    // Encola el tablero en el worker nativo y retorna su handle sin bloquear.
+    // callback recibe el progreso de cada iteración y el resultado final.
+    public native long solvePuzzleAsync(String puzzleMatrix, boolean parallel, long timeoutMillis, long maxNodes,
+                                        SolveCallback callback);
+    // Cancela una resolución asíncrona; su onResult llega igualmente. false si ya terminó.
+    public native boolean cancelSolve(long handle);
+    // Cancela las resoluciones en cola o en curso; se puede llamar desde cualquier hilo
+    public native void cancelSolves();
+    // Resuelve varios tableros a la vez en el pool nativo con una sola PatternDB.
+    // Cada resultado es "movimientos;microsegundos;nodos" (movimientos D/U/R/L del hueco)
+    // o un mensaje de error. Bloquea hasta terminar el lote.
+    public native String[] solveBatch(String[] puzzleMatrices);
+    // solveBatch con peso (ver solvePuzzleWeighted): "movimientos;microsegundos;nodos;factor"
+    public native String[] solveBatchWeighted(String[] puzzleMatrices, double weight);
 }
@@ -0,0 +1,12 @@
+package com.example.patterndb.NativeSolver;
+
+// Notificaciones de NativeSolver.solvePuzzleAsync. Se llaman desde el hilo
+// del worker nativo: para tocar la UI hay que pasar al hilo principal.
+public interface SolveCallback {
+    // Al empezar cada iteración de IDA*: límite actual (cota inferior de la
+    // longitud óptima) y nodos generados hasta ahora
+    void onProgress(long handle, int bound, long nodes);
+
+    // Resultado final, con el mismo formato que solvePuzzle (o el mensaje de error)
+    void onResult(long handle, String result);
+}
@@ -1,6 +1,5 @@
 package com.example.patterndb.View;
 
-import android.content.res.AssetManager;
 import android.os.Bundle;
 import android.widget.Chronometer;
 import android.os.SystemClock;
@@ -15,6 +14,7 @@ import android.widget.Toast;
 import androidx.appcompat.app.AppCompatActivity;
 
 import com.example.patterndb.NativeSolver.NativeSolver;
+import com.example.patterndb.NativeSolver.SolveCallback;
 import com.example.patterndb.R;
 
 import java.util.ArrayList;
@@ -26,8 +26,15 @@ public class MainActivity extends AppCompatActivity {
     private Button btnAddRow, btnAddColumn, btnSolve;
     private Chronometer chronometer;
     private TextView tvSteps;
+    private NativeSolver solver;
+    // Resolución asíncrona en curso (0 si no hay ninguna)
+    private long currentSolve = 0;
 
     // Dimensiones iniciales de la grilla
+    // Tamaños que resuelve el solver nativo (MIN_BOARD_SIDE / MAX_BOARD_SIDE en puzzle.h)
+    private static final int MIN_BOARD_SIDE = 2;
+    private static final int MAX_BOARD_SIDE = 6;
+
     private int numRows = 3;
     private int numCols = 3;
 
@@ -46,9 +53,28 @@ public class MainActivity extends AppCompatActivity {
         // Inicializa la grilla con dimensiones iniciales
         initializeGrid(null);
 
+        // Configura el solver nativo y precarga la PatternDB fuera del hilo de UI,
+        // así la primera resolución no paga el costo de carga
+        solver = new NativeSolver();
+        solver.setAssetManager(getAssets());
+        new Thread(new Runnable() {
+            @Override
+            public void run() {
+                // Preferir el binario (se mapea sin parsear) y usar el JSON como alternativa
+                if (!solver.preloadPatternDB("patternDb_4.pdb", 4)) {
+                    solver.preloadPatternDB("patternDb_4.json", 4);
+                }
+                // 6-6-6-6 para 5x5 (opcional: sin él se usa Manhattan + conflictos lineales)
+                solver.preloadPatternDB("patternDb_5.pdb", 5);
+            }
+        }).start();
+
         btnAddRow.setOnClickListener(new View.OnClickListener() {
             @Override
             public void onClick(View view) {
+                if (numRows >= MAX_BOARD_SIDE) {
+                    return;
+                }
                 List<List<String>> currentValues = getGridValues();
                 numRows++;
                 initializeGrid(currentValues);
@@ -58,6 +84,9 @@ public class MainActivity extends AppCompatActivity {
         btnAddColumn.setOnClickListener(new View.OnClickListener() {
             @Override
             public void onClick(View view) {
+                if (numCols >= MAX_BOARD_SIDE) {
+                    return;
+                }
                 List<List<String>> currentValues = getGridValues();
                 numCols++;
                 initializeGrid(currentValues);
@@ -76,49 +105,87 @@ public class MainActivity extends AppCompatActivity {
                     return;
                 }
 
-                // Verifica que el puzzle sea 4x4, ya que la función nativa lo espera
-                if (numRows != 4 || numCols != 4) {
-                    Toast.makeText(MainActivity.this, "El algoritmo nativo solo soporta puzzles 4x4.", Toast.LENGTH_SHORT).show();
+                // Verifica que el tamaño esté entre los que resuelve el solver nativo
+                if (numRows < MIN_BOARD_SIDE || numRows > MAX_BOARD_SIDE
+                        || numCols < MIN_BOARD_SIDE || numCols > MAX_BOARD_SIDE) {
+                    Toast.makeText(MainActivity.this, "El algoritmo nativo soporta puzzles de 2x2 a 6x6.", Toast.LENGTH_SHORT).show();
                     return;
                 }
 
                 // Formatea la matriz al string esperado: cada fila separada por ';' y números por espacios
                 StringBuilder inputBuilder = new StringBuilder();
-                for (int i = 0; i < 4; i++) {
-                    for (int j = 0; j < 4; j++) {
+                for (int i = 0; i < numRows; i++) {
+                    for (int j = 0; j < numCols; j++) {
                         inputBuilder.append(puzzleMatrix[i][j]);
-                        if (j < 3) {
+                        if (j < numCols - 1) {
                             inputBuilder.append(" ");
                         }
                     }
-                    if (i < 3) {
+                    if (i < numRows - 1) {
                         inputBuilder.append(";");
                     }
                 }
                 String inputMatrix = inputBuilder.toString();
 
-                // Inicia el cronómetro
-
+                // Una nueva resolución reemplaza a la anterior
+                if (currentSolve != 0) {
+                    solver.cancelSolve(currentSolve);
+                }
 
-                // Llama al método nativo implementado en C++/NDK
-                NativeSolver solver = new NativeSolver();
-                AssetManager assetManager = getAssets();
-                solver.setAssetManager(assetManager);
+                // Inicia el cronómetro y encola la resolución en el worker nativo;
+                // el hilo de UI no se bloquea
                 chronometer.setBase(SystemClock.elapsedRealtime());
                 chronometer.start();
-                String solutionPath = solver.solvePuzzle(inputMatrix);
+                tvSteps.setText("Buscando...");
+                currentSolve = solver.solvePuzzleAsync(inputMatrix, true, 0, 0, new SolveCallback() {
+                    @Override
+                    public void onProgress(final long handle, final int bound, final long nodes) {
+                        runOnUiThread(new Runnable() {
+                            @Override
+                            public void run() {
+                                if (handle == currentSolve) {
+                                    tvSteps.setText("Buscando soluciones de " + bound + " movimientos ("
+                                            + nodes + " nodos)...");
+                                }
+                            }
+                        });
+                    }
 
-                // Detiene el cronómetro
-                chronometer.stop();
-                long elapsedMillis = SystemClock.elapsedRealtime() - chronometer.getBase();
-                double elapsedSeconds = elapsedMillis / 1000.0;
+                    @Override
+                    public void onResult(final long handle, final String solutionPath) {
+                        runOnUiThread(new Runnable() {
+                            @Override
+                            public void run() {
+                                if (handle != currentSolve) {
+                                    return;
+                                }
+                                currentSolve = 0;
 
-                String result = solutionPath + "\nTiempo: " + elapsedSeconds + " segundos";
-                tvSteps.setText(result);
+                                // Detiene el cronómetro
+                                chronometer.stop();
+                                long elapsedMillis = SystemClock.elapsedRealtime() - chronometer.getBase();
+                                double elapsedSeconds = elapsedMillis / 1000.0;
+
+                                String result = solutionPath + "\nTiempo: " + elapsedSeconds + " segundos";
+                                tvSteps.setText(result);
+                            }
+                        });
+                    }
+                });
             }
         });
     }
 
+    @Override
+    protected void onDestroy() {
+        // No seguir buscando para una actividad que ya no existe
+        if (currentSolve != 0) {
+            solver.cancelSolve(currentSolve);
+            currentSolve = 0;
+        }
+        super.onDestroy();
+    }
+
     /**
      * Inicializa o reconstruye la grilla de EditTexts.
      *